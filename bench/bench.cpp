@@ -1,6 +1,15 @@
 
 #include <benchmark/benchmark.h>
-// #include "./pool_alloc.h"
+#include "./pool_alloc.h"
+#include "./concurrent_alloc.h"
+#include "./concurrent_priority_queue.h"
+#include "./concurrent_queue.h"
+#include "./concurrent_fenwick_tree.h"
 #include "./priority_queue.h"
+#include "./vector.h"
+#include "./small_vector.h"
+#include "./cow_vector.h"
+#include "./dijkstra.h"
+#include "./fenwick_tree.h"
 
 BENCHMARK_MAIN();
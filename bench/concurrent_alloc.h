@@ -0,0 +1,93 @@
+#pragma once
+#include "memory/BuddyResource.hpp"
+#include "memory/CachingBuddyResource.hpp"
+#include "memory/Mallocator.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace {
+
+// BuddyResource behind a single global lock, the naive way of sharing it.
+template <std::size_t Capacity, std::size_t BlockSize> class LockedBuddy {
+public:
+  void *allocate(std::size_t size, std::size_t align) {
+    std::lock_guard lock{m_mutex};
+    return m_core.allocate(size, align);
+  }
+  void deallocate(void *ptr, std::size_t size, std::size_t align) {
+    std::lock_guard lock{m_mutex};
+    m_core.deallocate(ptr, size, align);
+  }
+
+private:
+  std::mutex m_mutex;
+  strobe::BuddyResource<Capacity, BlockSize> m_core;
+};
+
+constexpr std::size_t ConcurrentCapacity = 1ull << 26;
+constexpr std::size_t ConcurrentBlockSize = 64;
+
+} // namespace
+
+// Every thread keeps a window of live allocations (64 - 512 bytes) and
+// randomly frees / allocates slots of it. The resource is shared between all
+// threads of the benchmark.
+template <typename Resource>
+static void BM_concurrent_alloc_churn(benchmark::State &state) {
+  static std::unique_ptr<Resource> resource;
+  if (state.thread_index() == 0) {
+    resource = std::make_unique<Resource>();
+  }
+  constexpr std::size_t Window = 256;
+  constexpr std::size_t OpsPerIteration = 1024;
+
+  std::vector<void *> ptrs(Window, nullptr);
+  std::vector<std::size_t> sizes(Window);
+  std::mt19937 rng(state.thread_index());
+  for (auto &size : sizes) {
+    size = ConcurrentBlockSize << (rng() % 4);
+  }
+  std::vector<std::size_t> slots(OpsPerIteration);
+  for (auto &slot : slots) {
+    slot = rng() % Window;
+  }
+
+  for (auto _ : state) {
+    for (std::size_t slot : slots) {
+      void *&ptr = ptrs[slot];
+      if (ptr == nullptr) {
+        ptr = resource->allocate(sizes[slot], ConcurrentBlockSize);
+      } else {
+        resource->deallocate(ptr, sizes[slot], ConcurrentBlockSize);
+        ptr = nullptr;
+      }
+    }
+  }
+  for (std::size_t i = 0; i < Window; ++i) {
+    if (ptrs[i] != nullptr) {
+      resource->deallocate(ptrs[i], sizes[i], ConcurrentBlockSize);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * OpsPerIteration);
+}
+
+using ConcurrentMalloc = strobe::Mallocator;
+BENCHMARK(BM_concurrent_alloc_churn<ConcurrentMalloc>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+using ConcurrentLockedBuddy =
+    LockedBuddy<ConcurrentCapacity, ConcurrentBlockSize>;
+BENCHMARK(BM_concurrent_alloc_churn<ConcurrentLockedBuddy>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+using ConcurrentCachingBuddy =
+    strobe::CachingBuddyResource<ConcurrentCapacity, ConcurrentBlockSize>;
+BENCHMARK(BM_concurrent_alloc_churn<ConcurrentCachingBuddy>)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
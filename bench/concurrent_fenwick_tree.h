@@ -0,0 +1,81 @@
+#pragma once
+#include "container/concurrent_fenwick_tree.hpp"
+#include "container/fenwick_tree.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace {
+
+// FenwickTree behind a single global lock, the naive way of sharing it.
+template <typename T> class LockedFenwickTree {
+public:
+  explicit LockedFenwickTree(std::size_t n) : m_tree(n) {}
+
+  void update(std::size_t i, T delta) {
+    std::lock_guard lock{m_mutex};
+    m_tree.update(i, delta);
+  }
+
+  T prefix_query(std::size_t r) {
+    std::lock_guard lock{m_mutex};
+    return m_tree.prefix_query(r);
+  }
+
+private:
+  std::mutex m_mutex;
+  FenwickTree<T> m_tree;
+};
+
+constexpr std::size_t ConcurrentFenwickSize = 1 << 16;
+
+} // namespace
+
+// Metrics aggregation: every thread adds to random counters, one in
+// range(0) operations is a prefix query over a random range.
+template <typename Tree>
+static void BM_concurrent_fenwick_update(benchmark::State &state) {
+  static std::unique_ptr<Tree> tree;
+  if (state.thread_index() == 0) {
+    tree = std::make_unique<Tree>(ConcurrentFenwickSize);
+  }
+  constexpr std::size_t OpsPerIteration = 1024;
+  const std::size_t queryEvery = state.range(0);
+  std::mt19937 prng(state.thread_index());
+  std::vector<std::size_t> indices(OpsPerIteration);
+  for (auto &i : indices) {
+    i = prng() % ConcurrentFenwickSize;
+  }
+
+  std::size_t op = 0;
+  for (auto _ : state) {
+    for (std::size_t i : indices) {
+      if (++op % queryEvery == 0) {
+        benchmark::DoNotOptimize(tree->prefix_query(i));
+      } else {
+        tree->update(i, 1);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * OpsPerIteration);
+}
+
+BENCHMARK(BM_concurrent_fenwick_update<LockedFenwickTree<std::int64_t>>)
+    ->Arg(1024)
+    ->Arg(16)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK(BM_concurrent_fenwick_update<AtomicFenwickTree<std::int64_t>>)
+    ->Arg(1024)
+    ->Arg(16)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK(BM_concurrent_fenwick_update<ShardedFenwickTree<std::int64_t>>)
+    ->Arg(1024)
+    ->Arg(16)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
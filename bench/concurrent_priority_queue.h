@@ -0,0 +1,183 @@
+#pragma once
+#include "container/fenwick_tree.hpp"
+#include "container/multi_queue.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// std::priority_queue behind a single global lock, the naive way of sharing
+// it.
+template <typename T> class LockedPriorityQueue {
+public:
+  explicit LockedPriorityQueue(std::size_t /*threads*/) {}
+
+  void push(const T &v) {
+    std::lock_guard lock{m_mutex};
+    m_queue.push(v);
+  }
+
+  std::optional<T> try_pop() {
+    std::lock_guard lock{m_mutex};
+    if (m_queue.empty()) {
+      return std::nullopt;
+    }
+    T top = m_queue.top();
+    m_queue.pop();
+    return top;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::priority_queue<T, std::vector<T>, std::greater<T>> m_queue;
+};
+
+constexpr std::size_t ConcurrentPQPrefill = 1 << 16;
+constexpr std::uint64_t ConcurrentPQMaxIncrement = 1 << 10;
+
+} // namespace
+
+// Hold model (as in parallel SSSP / branch and bound): every thread pops an
+// element and pushes a successor with a larger key. The queue is shared
+// between all threads of the benchmark.
+template <typename Queue>
+static void BM_concurrent_pq_hold(benchmark::State &state) {
+  static std::unique_ptr<Queue> queue;
+  if (state.thread_index() == 0) {
+    queue = std::make_unique<Queue>(state.threads());
+    std::mt19937_64 prng(0);
+    for (std::size_t i = 0; i < ConcurrentPQPrefill; ++i) {
+      queue->push(prng() % ConcurrentPQPrefill);
+    }
+  }
+  constexpr std::size_t OpsPerIteration = 1024;
+  std::mt19937_64 prng(state.thread_index());
+  std::vector<std::uint64_t> increments(OpsPerIteration);
+  for (auto &inc : increments) {
+    inc = 1 + prng() % ConcurrentPQMaxIncrement;
+  }
+
+  for (auto _ : state) {
+    for (std::uint64_t inc : increments) {
+      std::optional<std::uint64_t> top = queue->try_pop();
+      queue->push(top.value_or(0) + inc);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * OpsPerIteration * 2);
+}
+
+BENCHMARK(BM_concurrent_pq_hold<LockedPriorityQueue<std::uint64_t>>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_concurrent_pq_hold<strobe::MultiQueue<std::uint64_t>>)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Quality of the relaxed queue. Runs the hold model on range(0) threads, which
+// log the time and key of every operation. The log is replayed in time order
+// against an exact multiset (a FenwickTree over the compressed keys), the
+// rank error of a pop is the number of smaller keys, which were present at
+// that time.
+// NOTE: Pushes are logged before and pops after the operation, such that
+// every key is pushed before it is popped in the replay. The measured error
+// is therefore slightly pessimistic.
+template <typename Queue>
+static void BM_concurrent_pq_rank_error(benchmark::State &state) {
+  using Clock = std::chrono::steady_clock;
+  struct Event {
+    Clock::time_point time;
+    std::uint64_t key;
+    bool push;
+  };
+  const std::size_t threadCount = state.range(0);
+  constexpr std::size_t Prefill = 1 << 14;
+  constexpr std::size_t OpsPerThread = 1 << 14;
+
+  double meanError = 0;
+  std::size_t maxError = 0;
+  for (auto _ : state) {
+    Queue queue(threadCount);
+    std::vector<std::vector<Event>> logs(threadCount + 1);
+    std::mt19937_64 prng(0);
+    for (std::size_t i = 0; i < Prefill; ++i) {
+      const std::uint64_t key = prng() % Prefill;
+      logs[threadCount].push_back({Clock::now(), key, true});
+      queue.push(key);
+    }
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&, t] {
+        std::mt19937_64 prng(t);
+        auto &log = logs[t];
+        log.reserve(2 * OpsPerThread);
+        for (std::size_t i = 0; i < OpsPerThread; ++i) {
+          const std::optional<std::uint64_t> top = queue.try_pop();
+          if (top) {
+            log.push_back({Clock::now(), *top, false});
+          }
+          const std::uint64_t key =
+              top.value_or(0) + 1 + prng() % ConcurrentPQMaxIncrement;
+          log.push_back({Clock::now(), key, true});
+          queue.push(key);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    state.PauseTiming();
+    std::vector<Event> events;
+    for (const auto &log : logs) {
+      events.insert(events.end(), log.begin(), log.end());
+    }
+    std::ranges::stable_sort(events, {}, &Event::time);
+    std::vector<std::uint64_t> keys;
+    for (const Event &e : events) {
+      keys.push_back(e.key);
+    }
+    std::ranges::sort(keys);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    FenwickTree<std::int64_t> present(keys.size());
+    std::size_t pops = 0;
+    double errorSum = 0;
+    for (const Event &e : events) {
+      const std::size_t i = std::ranges::lower_bound(keys, e.key) - keys.begin();
+      if (e.push) {
+        present.update(i, 1);
+      } else {
+        const std::size_t error = i == 0 ? 0 : present.prefix_query(i - 1);
+        present.update(i, -1);
+        errorSum += error;
+        maxError = std::max(maxError, error);
+        ++pops;
+      }
+    }
+    meanError = errorSum / std::max<std::size_t>(1, pops);
+    state.ResumeTiming();
+  }
+  state.counters["rank_error_mean"] = meanError;
+  state.counters["rank_error_max"] = maxError;
+}
+
+BENCHMARK(BM_concurrent_pq_rank_error<LockedPriorityQueue<std::uint64_t>>)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Iterations(1)
+    ->UseRealTime();
+BENCHMARK(BM_concurrent_pq_rank_error<strobe::MultiQueue<std::uint64_t>>)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Iterations(1)
+    ->UseRealTime();
@@ -0,0 +1,192 @@
+#pragma once
+#include "container/mpmc_queue.hpp"
+#include "container/mpsc_queue.hpp"
+#include "container/spsc_queue.hpp"
+#include "container/treiber_stack.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// std::deque behind a single lock, the naive way of sharing a queue.
+template <typename T> class LockedQueue {
+public:
+  explicit LockedQueue(std::size_t /*capacity*/ = 0) {}
+
+  bool try_enqueue(const T &v) {
+    std::lock_guard lock{m_mutex};
+    m_queue.push_back(v);
+    return true;
+  }
+
+  std::optional<T> try_dequeue() {
+    std::lock_guard lock{m_mutex};
+    if (m_queue.empty()) {
+      return std::nullopt;
+    }
+    T front = m_queue.front();
+    m_queue.pop_front();
+    return front;
+  }
+
+  std::size_t enqueue_bulk(std::span<const T> values) {
+    std::lock_guard lock{m_mutex};
+    m_queue.insert(m_queue.end(), values.begin(), values.end());
+    return values.size();
+  }
+
+  std::size_t dequeue_bulk(std::span<T> out) {
+    std::lock_guard lock{m_mutex};
+    const std::size_t n = std::min(out.size(), m_queue.size());
+    std::copy_n(m_queue.begin(), n, out.begin());
+    m_queue.erase(m_queue.begin(), m_queue.begin() + n);
+    return n;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::deque<T> m_queue;
+};
+
+// The unbounded queue and the stack, with the interface of the bounded
+// queues.
+template <typename T> struct UnboundedMpscQueue : strobe::MpscQueue<T> {
+  explicit UnboundedMpscQueue(std::size_t /*capacity*/) {}
+  bool try_enqueue(const T &v) {
+    this->enqueue(v);
+    return true;
+  }
+};
+
+template <typename T> struct TreiberStackAsQueue : strobe::TreiberStack<T> {
+  explicit TreiberStackAsQueue(std::size_t /*capacity*/) {}
+  bool try_enqueue(const T &v) {
+    this->push(v);
+    return true;
+  }
+  std::optional<T> try_dequeue() { return this->try_pop(); }
+};
+
+constexpr std::size_t ConcurrentQueueCapacity = 1 << 12;
+
+} // namespace
+
+// Pipeline stage: thread 0 produces, thread 1 consumes range(0) elements per
+// batch (single elements are moved in batches of one).
+template <typename Queue>
+static void BM_spsc_queue_throughput(benchmark::State &state) {
+  static std::unique_ptr<Queue> queue;
+  if (state.thread_index() == 0) {
+    queue = std::make_unique<Queue>(ConcurrentQueueCapacity);
+  }
+  constexpr std::size_t ItemsPerIteration = 1 << 12;
+  const std::size_t batchSize = state.range(0);
+  std::array<std::uint64_t, 256> batch;
+  std::iota(batch.begin(), batch.end(), 0);
+
+  for (auto _ : state) {
+    std::size_t remaining = ItemsPerIteration;
+    while (remaining != 0) {
+      const std::size_t n = std::min(batchSize, remaining);
+      const std::size_t moved =
+          state.thread_index() == 0
+              ? queue->enqueue_bulk(std::span(batch).first(n))
+              : queue->dequeue_bulk(std::span(batch).first(n));
+      if (moved == 0) {
+        std::this_thread::yield();
+      }
+      remaining -= moved;
+    }
+  }
+  benchmark::DoNotOptimize(batch.data());
+  state.SetItemsProcessed(state.iterations() * ItemsPerIteration);
+}
+
+BENCHMARK(BM_spsc_queue_throughput<LockedQueue<std::uint64_t>>)
+    ->Arg(1)
+    ->Arg(64)
+    ->Threads(2)
+    ->UseRealTime();
+BENCHMARK(BM_spsc_queue_throughput<strobe::SpscQueue<std::uint64_t>>)
+    ->Arg(1)
+    ->Arg(64)
+    ->Threads(2)
+    ->UseRealTime();
+
+// range(0) producers hand 2^18 elements to range(1) consumers.
+template <typename Queue>
+static void BM_mpmc_queue_throughput(benchmark::State &state) {
+  constexpr std::uint64_t Items = 1 << 18;
+  const std::uint64_t producers = state.range(0);
+  const std::uint64_t consumers = state.range(1);
+  for (auto _ : state) {
+    Queue queue(ConcurrentQueueCapacity);
+    std::atomic<std::uint64_t> consumed{0};
+    std::vector<std::thread> threads;
+    for (std::uint64_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+        for (std::uint64_t i = p; i < Items; i += producers) {
+          while (!queue.try_enqueue(i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (std::uint64_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&] {
+        while (consumed.load(std::memory_order_relaxed) < Items) {
+          if (auto v = queue.try_dequeue()) {
+            benchmark::DoNotOptimize(*v);
+            consumed.fetch_add(1, std::memory_order_relaxed);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * Items);
+}
+
+static void ConcurrentQueueArgs(benchmark::internal::Benchmark *b) {
+  for (int producers : {1, 4, 16}) {
+    for (int consumers : {1, 4, 16}) {
+      b->Args({producers, consumers});
+    }
+  }
+}
+
+static void ConcurrentQueueSingleConsumerArgs(
+    benchmark::internal::Benchmark *b) {
+  for (int producers : {1, 4, 16}) {
+    b->Args({producers, 1});
+  }
+}
+
+BENCHMARK(BM_mpmc_queue_throughput<LockedQueue<std::uint64_t>>)
+    ->Apply(ConcurrentQueueArgs)
+    ->UseRealTime();
+BENCHMARK(BM_mpmc_queue_throughput<strobe::MpmcQueue<std::uint64_t>>)
+    ->Apply(ConcurrentQueueArgs)
+    ->UseRealTime();
+BENCHMARK(BM_mpmc_queue_throughput<UnboundedMpscQueue<std::uint64_t>>)
+    ->Apply(ConcurrentQueueSingleConsumerArgs)
+    ->UseRealTime();
+BENCHMARK(BM_mpmc_queue_throughput<TreiberStackAsQueue<std::uint64_t>>)
+    ->Apply(ConcurrentQueueArgs)
+    ->UseRealTime();
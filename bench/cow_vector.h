@@ -0,0 +1,43 @@
+#pragma once
+#include "container/cow_vector.hpp"
+#include "container/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <numeric>
+
+// Takes a snapshot of a lookup table and reads from it.
+template <typename Table> static void BM_snapshot(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  Table table(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    table[i] = static_cast<int>(i);
+  }
+  const Table &source = table;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const Table snapshot = source;
+    benchmark::DoNotOptimize(snapshot[i++ % n]);
+  }
+}
+
+// Takes a snapshot and writes to it once, the CowVector has to clone.
+template <typename Table>
+static void BM_snapshot_write(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  Table table(n);
+  const Table &source = table;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    Table snapshot = source;
+    snapshot[i++ % n] = 1;
+    benchmark::ClobberMemory();
+  }
+}
+
+using SnapshotVector = strobe::Vector<int>;
+BENCHMARK(BM_snapshot<SnapshotVector>)->Range(1 << 4, 1 << 20);
+BENCHMARK(BM_snapshot_write<SnapshotVector>)->Range(1 << 4, 1 << 20);
+
+using SnapshotCowVector = strobe::CowVector<int>;
+BENCHMARK(BM_snapshot<SnapshotCowVector>)->Range(1 << 4, 1 << 20);
+BENCHMARK(BM_snapshot_write<SnapshotCowVector>)->Range(1 << 4, 1 << 20);
@@ -0,0 +1,171 @@
+#pragma once
+#include "benchmark/benchmark.h"
+#include "container/binary_heap.hpp"
+#include "container/bucket_queue.hpp"
+#include "container/fibonaci_heap.hpp"
+#include "container/indexed_kary_heap.hpp"
+#include "container/kary_heap.hpp"
+#include "container/pairing_heap.hpp"
+#include "container/rank_pairing_heap.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Random graph with 8 outgoing edges per vertex and weights in [0, MaxWeight].
+struct DijkstraGraph {
+  static constexpr unsigned int MaxWeight = 255;
+  static constexpr unsigned int Degree = 8;
+  struct Edge {
+    unsigned int to;
+    unsigned int weight;
+  };
+
+  explicit DijkstraGraph(unsigned int n) : edges(std::size_t(n) * Degree) {
+    std::mt19937 prng(0);
+    std::uniform_int_distribution<unsigned int> vertex(0, n - 1);
+    std::uniform_int_distribution<unsigned int> weight(0, MaxWeight);
+    for (auto &e : edges) {
+      e = Edge{vertex(prng), weight(prng)};
+    }
+  }
+
+  unsigned int size() const { return edges.size() / Degree; }
+
+  std::vector<Edge> edges;
+};
+
+static constexpr unsigned int DijkstraInf =
+    std::numeric_limits<unsigned int>::max();
+
+// Dijkstra with lazy deletion, for queues without decrease_key.
+template <typename Queue>
+static void BM_DijkstraLazy(benchmark::State &state) {
+  const DijkstraGraph graph(state.range(0));
+  std::vector<unsigned int> dist(graph.size());
+  for (auto _ : state) {
+    std::ranges::fill(dist, DijkstraInf);
+    Queue queue;
+    dist[0] = 0;
+    queue.push({0, 0});
+    while (!queue.empty()) {
+      const auto [d, v] = queue.top();
+      queue.pop();
+      if (d != dist[v]) {
+        continue;
+      }
+      for (unsigned int i = 0; i < DijkstraGraph::Degree; ++i) {
+        const auto &e = graph.edges[v * DijkstraGraph::Degree + i];
+        if (d + e.weight < dist[e.to]) {
+          dist[e.to] = d + e.weight;
+          queue.push({d + e.weight, e.to});
+        }
+      }
+    }
+    benchmark::DoNotOptimize(dist.data());
+  }
+}
+
+// Dijkstra with decrease_key through handles.
+template <typename Queue>
+static void BM_DijkstraDecreaseKey(benchmark::State &state) {
+  const DijkstraGraph graph(state.range(0));
+  std::vector<unsigned int> dist(graph.size());
+  std::vector<typename Queue::handle> handles(graph.size());
+  std::vector<bool> settled(graph.size());
+  for (auto _ : state) {
+    std::ranges::fill(dist, DijkstraInf);
+    std::ranges::fill(handles, nullptr);
+    std::fill(settled.begin(), settled.end(), false);
+    Queue queue;
+    dist[0] = 0;
+    handles[0] = queue.push({0, 0});
+    while (!queue.empty()) {
+      const auto [d, v] = queue.top();
+      queue.pop();
+      settled[v] = true;
+      for (unsigned int i = 0; i < DijkstraGraph::Degree; ++i) {
+        const auto &e = graph.edges[v * DijkstraGraph::Degree + i];
+        if (settled[e.to] || d + e.weight >= dist[e.to]) {
+          continue;
+        }
+        dist[e.to] = d + e.weight;
+        if (handles[e.to] == nullptr) {
+          handles[e.to] = queue.push({d + e.weight, e.to});
+        } else {
+          queue.decrease_key(handles[e.to], {d + e.weight, e.to});
+        }
+      }
+    }
+    benchmark::DoNotOptimize(dist.data());
+  }
+}
+
+// Dijkstra with decrease_key through vertex ids.
+template <typename Queue>
+static void BM_DijkstraIndexed(benchmark::State &state) {
+  const DijkstraGraph graph(state.range(0));
+  std::vector<unsigned int> dist(graph.size());
+  for (auto _ : state) {
+    std::ranges::fill(dist, DijkstraInf);
+    Queue queue(graph.size());
+    dist[0] = 0;
+    queue.push(0, 0);
+    while (!queue.empty()) {
+      const unsigned int d = queue.top();
+      const unsigned int v = queue.top_id();
+      queue.pop();
+      for (unsigned int i = 0; i < DijkstraGraph::Degree; ++i) {
+        const auto &e = graph.edges[v * DijkstraGraph::Degree + i];
+        if (d + e.weight >= dist[e.to]) {
+          continue;
+        }
+        // Settled vertices never pass the check above.
+        const bool queued = dist[e.to] != DijkstraInf;
+        dist[e.to] = d + e.weight;
+        if (!queued) {
+          queue.push(e.to, d + e.weight);
+        } else {
+          queue.decrease_key(e.to, d + e.weight);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(dist.data());
+  }
+}
+
+using DijkstraEntry = std::pair<unsigned int, unsigned int>;
+struct DijkstraKey {
+  unsigned int operator()(const DijkstraEntry &e) const { return e.first; }
+};
+// Keys of the queue never span more than MaxWeight + 1 distinct values.
+struct DijkstraBucketQueue : strobe::BucketQueue<DijkstraEntry, DijkstraKey> {
+  DijkstraBucketQueue() : BucketQueue(DijkstraGraph::MaxWeight + 1) {}
+};
+
+BENCHMARK(BM_DijkstraLazy<strobe::BinaryHeap<DijkstraEntry>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraLazy<strobe::KAryHeap<DijkstraEntry, 4>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraLazy<
+              std::priority_queue<DijkstraEntry, std::vector<DijkstraEntry>,
+                                  std::greater<DijkstraEntry>>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraDecreaseKey<strobe::FibonaciHeap<DijkstraEntry>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraDecreaseKey<strobe::PairingHeap<DijkstraEntry>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraDecreaseKey<strobe::RankPairingHeap<DijkstraEntry>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraDecreaseKey<DijkstraBucketQueue>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraIndexed<strobe::IndexedKAryHeap<unsigned int, 2>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraIndexed<strobe::IndexedKAryHeap<unsigned int, 4>>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_DijkstraIndexed<strobe::IndexedKAryHeap<unsigned int, 8>>)
+    ->Range(1 << 10, 1 << 18);
@@ -0,0 +1,76 @@
+#pragma once
+#include "benchmark/benchmark.h"
+#include "container/blocked_fenwick_tree.hpp"
+#include "container/fenwick_tree.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+// Trees of up to 10^9 elements take gigabytes, only the most recently used
+// tree is kept alive between the runs of a benchmark.
+template <typename Tree> Tree &cachedFenwickTree(std::size_t n) {
+  static std::shared_ptr<void> tree;
+  static const std::type_info *type = nullptr;
+  static std::size_t size = 0;
+  if (tree == nullptr || type != &typeid(Tree) || size != n) {
+    tree.reset();
+    tree = std::make_shared<Tree>(n);
+    type = &typeid(Tree);
+    size = n;
+  }
+  return *static_cast<Tree *>(tree.get());
+}
+
+constexpr std::size_t FenwickOpsPerIteration = 1024;
+
+std::vector<std::size_t> randomFenwickIndices(std::size_t n) {
+  std::mt19937_64 prng(n);
+  std::vector<std::size_t> indices(FenwickOpsPerIteration);
+  for (auto &i : indices) {
+    i = prng() % n;
+  }
+  return indices;
+}
+
+} // namespace
+
+template <typename Tree> static void BM_FenwickUpdate(benchmark::State &state) {
+  Tree &tree = cachedFenwickTree<Tree>(state.range(0));
+  const std::vector<std::size_t> indices = randomFenwickIndices(state.range(0));
+  for (auto _ : state) {
+    for (std::size_t i : indices) {
+      tree.update(i, 1);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * FenwickOpsPerIteration);
+}
+
+template <typename Tree>
+static void BM_FenwickPrefixQuery(benchmark::State &state) {
+  Tree &tree = cachedFenwickTree<Tree>(state.range(0));
+  const std::vector<std::size_t> indices = randomFenwickIndices(state.range(0));
+  for (auto _ : state) {
+    for (std::size_t i : indices) {
+      benchmark::DoNotOptimize(tree.prefix_query(i));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * FenwickOpsPerIteration);
+}
+
+BENCHMARK(BM_FenwickUpdate<FenwickTree<std::uint32_t>>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000'000);
+BENCHMARK(BM_FenwickUpdate<BlockedFenwickTree<std::uint32_t>>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000'000);
+BENCHMARK(BM_FenwickPrefixQuery<FenwickTree<std::uint32_t>>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000'000);
+BENCHMARK(BM_FenwickPrefixQuery<BlockedFenwickTree<std::uint32_t>>)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000'000);
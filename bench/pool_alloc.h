@@ -1,10 +1,16 @@
+#pragma once
 #include "memory/BuddyResource.hpp"
+#include "memory/DynamicBuddyResource.hpp"
+#include "memory/FreelistPool.hpp"
+#include "memory/Mallocator.hpp"
 #include <algorithm>
 #include <benchmark/benchmark.h>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <random>
+#include <vector>
 
 template <typename Allocator>
 static void BM_pool_random_order(benchmark::State &state, Allocator alloc) {
@@ -42,15 +48,15 @@ static void BM_pool_random_order(benchmark::State &state, Allocator alloc) {
   }
 }
 
-//BENCHMARK_CAPTURE(BM_pool_random_order<strobe::Mallocator>, malloc,
-//                  strobe::Mallocator{})
-//    ->Args({8, 1 << 10})
-//    ->Args({16, 1 << 10})
-//    ->Args({64, 1 << 10})
-//    ->Args({256, 1 << 10})
-//    ->Args({1024, 1 << 10})
-//    ->Args({4096, 1 << 10})
-//    ->Args({8192, 1 << 10});
+BENCHMARK_CAPTURE(BM_pool_random_order<strobe::Mallocator>, malloc,
+                  strobe::Mallocator{})
+    ->Args({8, 1 << 10})
+    ->Args({16, 1 << 10})
+    ->Args({64, 1 << 10})
+    ->Args({256, 1 << 10})
+    ->Args({1024, 1 << 10})
+    ->Args({4096, 1 << 10})
+    ->Args({8192, 1 << 10});
 
 using Buddy8 = strobe::BuddyResource<(1ull << 10) * 8, 8>;
 BENCHMARK_CAPTURE(BM_pool_random_order<Buddy8>, buddy, Buddy8{})
@@ -90,3 +96,154 @@ BENCHMARK_CAPTURE(BM_pool_random_order<Buddy8192>, buddy, Buddy8192{})
 //  ->Args({4096, 1 << 10})
 //  ->Args({8192, 1 << 10});
 
+using Freelist8 = strobe::FreelistResource<8, 8>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist8>, freelist, Freelist8{})
+    ->Args({8, 1 << 10});
+
+using Freelist16 = strobe::FreelistResource<16, 16>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist16>, freelist, Freelist16{})
+    ->Args({16, 1 << 10});
+
+using Freelist64 = strobe::FreelistResource<64, 64>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist64>, freelist, Freelist64{})
+    ->Args({64, 1 << 10});
+
+using Freelist256 = strobe::FreelistResource<256, 256>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist256>, freelist, Freelist256{})
+    ->Args({256, 1 << 10});
+
+using Freelist1024 = strobe::FreelistResource<1024, 1024>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist1024>, freelist,
+                  Freelist1024{})
+    ->Args({1024, 1 << 10});
+
+using Freelist4096 = strobe::FreelistResource<4096, 4096>;
+BENCHMARK_CAPTURE(BM_pool_random_order<Freelist4096>, freelist,
+                  Freelist4096{})
+    ->Args({4096, 1 << 10});
+
+// Deep buddy tree where the lower half of the capacity is completely
+// allocated with the smallest blocks. Every allocation of a small block then
+// has to search upwards to the free upper half (order 1), split it down and
+// the following deallocation coalesces it back up again.
+template <typename Resource>
+static void BM_buddy_fragmented_ping_pong(benchmark::State &state,
+                                          std::size_t capacity,
+                                          std::size_t blockSize) {
+  auto resource = std::make_unique<Resource>();
+  std::vector<void *> ptrs(capacity / 2 / blockSize);
+  for (auto &ptr : ptrs) {
+    ptr = resource->allocate(blockSize, blockSize);
+    assert(ptr);
+  }
+  const std::size_t allocSize = blockSize * state.range(0);
+  for (auto _ : state) {
+    void *ptr = resource->allocate(allocSize, blockSize);
+    benchmark::DoNotOptimize(ptr);
+    resource->deallocate(ptr, allocSize, blockSize);
+  }
+  for (auto ptr : ptrs) {
+    resource->deallocate(ptr, blockSize, blockSize);
+  }
+}
+
+using BuddyDeep16 = strobe::BuddyResource<(1ull << 16), 16>;
+BENCHMARK_CAPTURE(BM_buddy_fragmented_ping_pong<BuddyDeep16>, depth12,
+                  1ull << 16, 16)
+    ->Arg(1)
+    ->Arg(16);
+
+using BuddyDeep20 = strobe::BuddyResource<(1ull << 20), 16>;
+BENCHMARK_CAPTURE(BM_buddy_fragmented_ping_pong<BuddyDeep20>, depth16,
+                  1ull << 20, 16)
+    ->Arg(1)
+    ->Arg(16);
+
+using BuddyDeep24 = strobe::BuddyResource<(1ull << 24), 16>;
+BENCHMARK_CAPTURE(BM_buddy_fragmented_ping_pong<BuddyDeep24>, depth20,
+                  1ull << 24, 16)
+    ->Arg(1)
+    ->Arg(16);
+
+// Every other smallest block is freed, leaving the smallest order with a long
+// freelist while all larger orders are empty. Medium sized allocations have
+// to skip all the empty orders to find a larger block.
+template <typename Resource>
+static void BM_buddy_fragmented_checkerboard(benchmark::State &state,
+                                             std::size_t capacity,
+                                             std::size_t blockSize) {
+  auto resource = std::make_unique<Resource>();
+  std::vector<void *> ptrs(capacity / 2 / blockSize);
+  for (auto &ptr : ptrs) {
+    ptr = resource->allocate(blockSize, blockSize);
+  }
+  for (std::size_t i = 0; i < ptrs.size(); i += 2) {
+    resource->deallocate(ptrs[i], blockSize, blockSize);
+    ptrs[i] = nullptr;
+  }
+  const std::size_t allocSize = blockSize * state.range(0);
+  std::vector<void *> batch(64);
+  for (auto _ : state) {
+    for (auto &ptr : batch) {
+      ptr = resource->allocate(allocSize, blockSize);
+    }
+    for (auto ptr : batch) {
+      resource->deallocate(ptr, allocSize, blockSize);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch.size());
+  for (auto ptr : ptrs) {
+    if (ptr != nullptr) {
+      resource->deallocate(ptr, blockSize, blockSize);
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_buddy_fragmented_checkerboard<BuddyDeep20>, depth16,
+                  1ull << 20, 16)
+    ->Arg(4)
+    ->Arg(64);
+
+BENCHMARK_CAPTURE(BM_buddy_fragmented_checkerboard<BuddyDeep24>, depth20,
+                  1ull << 24, 16)
+    ->Arg(4)
+    ->Arg(64);
+
+// All arenas of a DynamicBuddyResource are completely allocated, blocks are
+// alternately freed and reallocated in the two arenas with the highest
+// address. Every allocation first has to fail in all full arenas before it
+// finds the free block.
+template <typename Resource>
+static void BM_buddy_full_arenas(benchmark::State &state,
+                                 std::size_t arenaCapacity,
+                                 std::size_t blockSize) {
+  Resource resource{arenaCapacity};
+  const std::size_t blocksPerArena = arenaCapacity / blockSize;
+  std::vector<void *> ptrs(blocksPerArena * state.range(0));
+  for (auto &ptr : ptrs) {
+    ptr = resource.allocate(blockSize, blockSize);
+  }
+  std::ranges::sort(ptrs);
+  void *&a = ptrs.back();
+  void *&b = ptrs[ptrs.size() - 1 - blocksPerArena];
+  for (auto _ : state) {
+    resource.deallocate(a, blockSize, blockSize);
+    a = resource.allocate(blockSize, blockSize);
+    resource.deallocate(b, blockSize, blockSize);
+    b = resource.allocate(blockSize, blockSize);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+  for (auto ptr : ptrs) {
+    resource.deallocate(ptr, blockSize, blockSize);
+  }
+}
+
+using DynamicBuddy16 = strobe::DynamicBuddyResource<16>;
+BENCHMARK_CAPTURE(BM_buddy_full_arenas<DynamicBuddy16>, depth12, 1ull << 16,
+                  16)
+    ->Arg(8)
+    ->Arg(64);
+BENCHMARK_CAPTURE(BM_buddy_full_arenas<DynamicBuddy16>, depth16, 1ull << 20,
+                  16)
+    ->Arg(8)
+    ->Arg(64);
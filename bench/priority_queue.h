@@ -1,10 +1,17 @@
 #pragma once
 #include "benchmark/benchmark.h"
 #include "container/binary_heap.hpp"
+#include "container/fibonaci_heap.hpp"
 #include "container/kary_heap.hpp"
+#include "container/pairing_heap.hpp"
+#include "container/radix_heap.hpp"
+#include "container/rank_pairing_heap.hpp"
+#include <cstdint>
 #include <iostream>
 #include <queue>
 #include <random>
+#include <utility>
+#include <vector>
 
 static void BM_BinaryHeapInsert(benchmark::State &state) {
   std::mt19937 prng(0);
@@ -108,7 +115,7 @@ static void BM_Kary2HeapRandomizedInsertRemove(benchmark::State &state) {
   // Perform setup here
   for (auto _ : state) {
     // state.PauseTiming();
-    strobe::KAryHeap<int, 4> heap;
+    strobe::KAryHeap<int, 2> heap;
     // heap.reserve(COUNT);
     // state.ResumeTiming();
 
@@ -176,7 +183,7 @@ static void BM_Kary8HeapRandomizedInsertRemove(benchmark::State &state) {
   // Perform setup here
   for (auto _ : state) {
     // state.PauseTiming();
-    strobe::KAryHeap<int, 4> heap;
+    strobe::KAryHeap<int, 8> heap;
     // heap.reserve(COUNT);
     // state.ResumeTiming();
 
@@ -191,6 +198,45 @@ static void BM_Kary8HeapRandomizedInsertRemove(benchmark::State &state) {
   }
 }
 
+// Same as BM_Kary8HeapRandomizedInsertRemove, for any heap type.
+template <typename Heap>
+static void BM_KaryHeapRandomizedInsertRemove(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(1);
+  std::uniform_int_distribution<int> choice(0, 1);
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<typename Heap::value_type> values(COUNT);
+  for (auto &v : values) {
+    if (choice(prng)) {
+      v = 0;
+    } else {
+      v = dist(prng);
+    }
+  }
+
+  for (auto _ : state) {
+    Heap heap;
+    for (const auto &v : values) {
+      if (v == 0 && !heap.empty()) {
+        heap.pop();
+      } else {
+        heap.push(v);
+      }
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Not std::less, therefore KAryHeap never selects children with SIMD.
+template <typename T> struct ScalarLess {
+  bool operator()(const T &a, const T &b) const { return a < b; }
+};
+
+template <typename T, std::size_t K>
+using ScalarKAryHeap = strobe::KAryHeap<T, K, strobe::Vector<T>, ScalarLess<T>>;
+
 static void BM_StdPriorityQueueRandomizedInsertRemove(benchmark::State &state) {
   std::mt19937 prng(0);
   std::uniform_int_distribution<int> dist(1);
@@ -224,6 +270,279 @@ static void BM_StdPriorityQueueRandomizedInsertRemove(benchmark::State &state) {
   }
 }
 
+// Event simulation: COUNT pending events, every popped event schedules a new
+// event at a later time, i.e. the keys are monotone.
+template <typename Heap>
+static void BM_MonotoneEventSimulation(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<unsigned int> delay(0, 1 << 16);
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<unsigned int> delays(COUNT * 4);
+  for (auto &d : delays) {
+    d = delay(prng);
+  }
+
+  for (auto _ : state) {
+    Heap heap;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      heap.push(delays[i]);
+    }
+    for (std::size_t i = COUNT; i < delays.size(); ++i) {
+      const unsigned int now = heap.top();
+      heap.pop();
+      heap.push(now + delays[i]);
+    }
+    while (!heap.empty()) {
+      heap.pop();
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// COUNT elements in the heap, every pop is followed by a push, i.e. the heap
+// stays at COUNT elements and every operation sifts down through all levels.
+template <typename Heap>
+static void BM_KaryHeapSteadyStatePopPush(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(1);
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT * 2);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+
+  Heap heap;
+  heap.reserve(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    heap.push(values[i]);
+  }
+  std::size_t i = COUNT;
+  for (auto _ : state) {
+    heap.pop();
+    heap.push(values[i]);
+    if (++i == values.size()) {
+      i = COUNT;
+    }
+  }
+  benchmark::DoNotOptimize(heap);
+}
+
+// Builds a heap from COUNT random elements, by repeated push.
+template <typename Heap>
+static void BM_HeapBuildByPush(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist;
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+
+  for (auto _ : state) {
+    Heap heap;
+    heap.reserve(COUNT);
+    for (const auto &v : values) {
+      heap.push(v);
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Builds a heap from COUNT random elements, with the range constructor.
+template <typename Heap>
+static void BM_HeapBuildFromRange(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist;
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+
+  for (auto _ : state) {
+    Heap heap(values);
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Batch loader: pushes batches of COUNT elements into a heap, which already
+// holds COUNT elements.
+template <typename Heap, bool PushRange>
+static void BM_HeapBatchLoad(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist;
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+  std::vector<int> batch(COUNT);
+  for (auto &v : batch) {
+    v = dist(prng);
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Heap heap(values);
+    heap.reserve(2 * COUNT);
+    state.ResumeTiming();
+    if constexpr (PushRange) {
+      heap.push_range(batch);
+    } else {
+      for (const auto &v : batch) {
+        heap.push(v);
+      }
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Node churn of an addressable heap: COUNT elements are pushed, half of them
+// get a decreased key, then all are popped.
+template <typename Heap>
+static void BM_AddressableHeapChurn(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(1 << 20, 1 << 30);
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+  std::vector<typename Heap::handle> handles(COUNT);
+
+  for (auto _ : state) {
+    Heap heap;
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      handles[i] = heap.push(values[i]);
+    }
+    for (std::size_t i = 0; i < COUNT; i += 2) {
+      heap.decrease_key(handles[i], values[i] >> 10);
+    }
+    while (!heap.empty()) {
+      heap.pop();
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Node allocation only: COUNT elements are pushed, then the heap is cleared.
+template <typename Heap>
+static void BM_AddressableHeapPushClear(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist;
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+
+  Heap heap;
+  for (auto _ : state) {
+    for (const auto &v : values) {
+      heap.push(v);
+    }
+    heap.clear();
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Heavy decrease_key: COUNT elements are pushed, every pop is followed by
+// 4 decrease_key on random elements, which are still in the heap.
+template <typename Heap>
+static void BM_AddressableHeapDecreaseKeyHeavy(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(1 << 20, 1 << 30);
+
+  std::size_t COUNT = state.range(0);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+  std::vector<std::uint32_t> picks(COUNT * 4);
+  for (auto &p : picks) {
+    p = static_cast<std::uint32_t>(prng() % COUNT);
+  }
+  std::vector<typename Heap::handle> handles(COUNT);
+  std::vector<int> keys(COUNT);
+  std::vector<bool> popped(COUNT);
+
+  for (auto _ : state) {
+    Heap heap;
+    keys = values;
+    std::fill(popped.begin(), popped.end(), false);
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      handles[i] = heap.push({keys[i], static_cast<std::uint32_t>(i)});
+    }
+    std::size_t p = 0;
+    while (!heap.empty()) {
+      popped[heap.top().second] = true;
+      heap.pop();
+      for (std::size_t j = 0; j < 4; ++j, ++p) {
+        const std::uint32_t i = picks[p];
+        if (!popped[i]) {
+          keys[i] -= static_cast<int>(i & 1023);
+          heap.decrease_key(handles[i], {keys[i], i});
+        }
+      }
+    }
+    benchmark::DoNotOptimize(heap);
+  }
+}
+
+// Sharded scheduler: range(1) per-worker heaps with range(0) elements in
+// total are melded into a single heap.
+// NOTE: Only the meld is timed, the iteration count is fixed, because
+// building the sub-heaps is orders of magnitude slower than a meld, which is
+// O(1) for the node heaps and O(n + m) for the array heaps.
+template <typename Heap>
+static void BM_HeapMeldK(benchmark::State &state) {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist;
+
+  std::size_t COUNT = state.range(0);
+  std::size_t K = state.range(1);
+
+  std::vector<int> values(COUNT);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<Heap> heaps(K);
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      heaps[i % K].push(values[i]);
+    }
+    state.ResumeTiming();
+    for (std::size_t k = 1; k < K; ++k) {
+      heaps.front().meld(std::move(heaps[k]));
+    }
+    benchmark::DoNotOptimize(heaps.front().top());
+    state.PauseTiming();
+    heaps.clear();
+    state.ResumeTiming();
+  }
+}
+
+template <typename T>
+using MallocFibonaciHeap =
+    strobe::FibonaciHeap<T, std::less<T>, strobe::Mallocator>;
+
 BENCHMARK(BM_BinaryHeapInsert) //
     ->Arg(1000)
     ->Arg(10000)
@@ -260,8 +579,153 @@ BENCHMARK(BM_Kary8HeapRandomizedInsertRemove) //
     ->Arg(100000)
     ->Arg(1000000);
 
+BENCHMARK(BM_KaryHeapRandomizedInsertRemove<ScalarKAryHeap<int, 8>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_KaryHeapRandomizedInsertRemove<strobe::KAryHeap<int, 16>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_KaryHeapRandomizedInsertRemove<ScalarKAryHeap<int, 16>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_KaryHeapRandomizedInsertRemove<strobe::KAryHeap<float, 8>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_KaryHeapRandomizedInsertRemove<ScalarKAryHeap<float, 8>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
 BENCHMARK(BM_StdPriorityQueueRandomizedInsertRemove) //
     ->Arg(1000)
     ->Arg(10000)
     ->Arg(100000)
     ->Arg(1000000);
+
+BENCHMARK(BM_MonotoneEventSimulation<strobe::BinaryHeap<unsigned int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_MonotoneEventSimulation<strobe::KAryHeap<unsigned int, 4>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_MonotoneEventSimulation<strobe::RadixHeap<unsigned int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<strobe::KAryHeap<int, 4>>) //
+    ->Arg(10000000);
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<strobe::CacheAlignedKAryHeap<int, 4>>) //
+    ->Arg(10000000);
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<strobe::KAryHeap<int, 8>>) //
+    ->Arg(10000000);
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<strobe::CacheAlignedKAryHeap<int, 8>>) //
+    ->Arg(10000000);
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<ScalarKAryHeap<int, 8>>) //
+    ->Arg(10000000);
+BENCHMARK(BM_KaryHeapSteadyStatePopPush<
+              strobe::KAryHeap<int, 8, strobe::Vector<int, strobe::AlignedAllocator<>>,
+                               ScalarLess<int>, true>>) //
+    ->Arg(10000000);
+
+BENCHMARK(BM_HeapBuildByPush<strobe::BinaryHeap<int>>)->Arg(1000000);
+BENCHMARK(BM_HeapBuildFromRange<strobe::BinaryHeap<int>>)->Arg(1000000);
+BENCHMARK(BM_HeapBuildByPush<strobe::KAryHeap<int, 4>>)->Arg(1000000);
+BENCHMARK(BM_HeapBuildFromRange<strobe::KAryHeap<int, 4>>)->Arg(1000000);
+BENCHMARK(BM_HeapBuildByPush<strobe::KAryHeap<int, 8>>)->Arg(1000000);
+BENCHMARK(BM_HeapBuildFromRange<strobe::KAryHeap<int, 8>>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::BinaryHeap<int>, false>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::BinaryHeap<int>, true>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::KAryHeap<int, 4>, false>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::KAryHeap<int, 4>, true>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::KAryHeap<int, 8>, false>)->Arg(1000000);
+BENCHMARK(BM_HeapBatchLoad<strobe::KAryHeap<int, 8>, true>)->Arg(1000000);
+
+BENCHMARK(BM_AddressableHeapChurn<strobe::FibonaciHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapChurn<MallocFibonaciHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapPushClear<strobe::FibonaciHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapPushClear<MallocFibonaciHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapDecreaseKeyHeavy<
+              strobe::FibonaciHeap<std::pair<int, std::uint32_t>>>) //
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapDecreaseKeyHeavy<
+              strobe::PairingHeap<std::pair<int, std::uint32_t>>>) //
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapDecreaseKeyHeavy<
+              strobe::RankPairingHeap<std::pair<int, std::uint32_t>>>) //
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapChurn<strobe::PairingHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_AddressableHeapChurn<strobe::RankPairingHeap<int>>) //
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK(BM_HeapMeldK<strobe::BinaryHeap<int>>) //
+    ->Args({1000000, 2})
+    ->Args({1000000, 16})
+    ->Args({1000000, 256})
+    ->Iterations(20);
+BENCHMARK(BM_HeapMeldK<strobe::KAryHeap<int, 4>>) //
+    ->Args({1000000, 2})
+    ->Args({1000000, 16})
+    ->Args({1000000, 256})
+    ->Iterations(20);
+BENCHMARK(BM_HeapMeldK<strobe::FibonaciHeap<int>>) //
+    ->Args({1000000, 2})
+    ->Args({1000000, 16})
+    ->Args({1000000, 256})
+    ->Iterations(20);
+BENCHMARK(BM_HeapMeldK<strobe::PairingHeap<int>>) //
+    ->Args({1000000, 2})
+    ->Args({1000000, 16})
+    ->Args({1000000, 256})
+    ->Iterations(20);
+BENCHMARK(BM_HeapMeldK<strobe::RankPairingHeap<int>>) //
+    ->Args({1000000, 2})
+    ->Args({1000000, 16})
+    ->Args({1000000, 256})
+    ->Iterations(20);
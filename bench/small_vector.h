@@ -0,0 +1,39 @@
+#pragma once
+#include "container/small_vector.hpp"
+#include "container/vector.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+
+// Builds many tiny lists (e.g. adjacency lists), reads them back and
+// destroys them again.
+template <typename List>
+static void BM_small_lists(benchmark::State &state) {
+  constexpr std::size_t ListCount = 1 << 14;
+  const std::size_t n = state.range(0);
+  for (auto _ : state) {
+    std::vector<List> lists(ListCount);
+    for (std::size_t i = 0; i < ListCount; ++i) {
+      for (std::size_t j = 0; j < n; ++j) {
+        lists[i].push_back(static_cast<int>(i + j));
+      }
+    }
+    long sum = 0;
+    for (const List &list : lists) {
+      for (int v : list) {
+        sum += v;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * ListCount * n);
+}
+
+using SmallListVector = strobe::Vector<int>;
+BENCHMARK(BM_small_lists<SmallListVector>)->DenseRange(1, 4)->Arg(8)->Arg(16);
+
+using SmallListInline4 = strobe::SmallVector<int, 4>;
+BENCHMARK(BM_small_lists<SmallListInline4>)->DenseRange(1, 4)->Arg(8)->Arg(16);
+
+using SmallListInline8 = strobe::SmallVector<int, 8>;
+BENCHMARK(BM_small_lists<SmallListInline8>)->DenseRange(1, 4)->Arg(8)->Arg(16);
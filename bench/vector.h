@@ -0,0 +1,70 @@
+#pragma once
+#include "container/vector.hpp"
+#include "memory/Mallocator.hpp"
+#include "memory/PageAllocator.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+// Forwards only allocate / deallocate, which hides the reallocate and
+// allocate_at_least of the upstream allocator from the Vector.
+template <typename Upstream> class PlainAllocator {
+public:
+  void *allocate(std::size_t size, std::size_t align) {
+    return m_upstream.allocate(size, align);
+  }
+  void deallocate(void *ptr, std::size_t size, std::size_t align) {
+    m_upstream.deallocate(ptr, size, align);
+  }
+
+private:
+  [[no_unique_address]] Upstream m_upstream;
+};
+
+} // namespace
+
+template <typename Vec> static void BM_vector_push_back(benchmark::State &state) {
+  const std::size_t n = state.range(0);
+  for (auto _ : state) {
+    Vec vec;
+    for (std::size_t i = 0; i < n; ++i) {
+      vec.push_back(static_cast<int>(i));
+    }
+    benchmark::DoNotOptimize(vec);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// NOTE: 1e9 ints grow the vector to 4GiB, copying growth temporarily needs
+// 6GiB.
+using StdVectorInt = std::vector<int>;
+BENCHMARK(BM_vector_push_back<StdVectorInt>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000000)
+    ->Unit(benchmark::kMillisecond);
+
+using VectorMallocCopy = strobe::Vector<int, PlainAllocator<strobe::Mallocator>>;
+BENCHMARK(BM_vector_push_back<VectorMallocCopy>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000000)
+    ->Unit(benchmark::kMillisecond);
+
+using VectorMallocRealloc = strobe::Vector<int, strobe::Mallocator>;
+BENCHMARK(BM_vector_push_back<VectorMallocRealloc>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000000)
+    ->Unit(benchmark::kMillisecond);
+
+using VectorPageCopy = strobe::Vector<int, PlainAllocator<strobe::PageAllocator>>;
+BENCHMARK(BM_vector_push_back<VectorPageCopy>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000000)
+    ->Unit(benchmark::kMillisecond);
+
+using VectorPageRemap = strobe::Vector<int, strobe::PageAllocator>;
+BENCHMARK(BM_vector_push_back<VectorPageRemap>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000000)
+    ->Unit(benchmark::kMillisecond);
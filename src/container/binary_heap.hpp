@@ -1,8 +1,13 @@
 #pragma once
 
 #include "container/vector.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
 #include <bit>
+#include <cassert>
 #include <functional>
+#include <iterator>
+#include <ranges>
 #include <type_traits>
 
 namespace strobe {
@@ -23,6 +28,15 @@ public:
     requires(std::is_default_constructible_v<container> &&
              std::is_default_constructible_v<comparator>)
       : m_container(), m_comparator() {}
+  /// Builds the heap from range with a bottom-up heapify in O(n).
+  template <std::ranges::input_range R>
+    requires(std::convertible_to<std::ranges::range_reference_t<R>,
+                                 value_type> &&
+             std::is_default_constructible_v<container>)
+  explicit BinaryHeap(R &&range, const Compare &compare = {})
+      : m_container(), m_comparator(compare) {
+    push_range(std::forward<R>(range));
+  }
   BinaryHeap(const BinaryHeap &) = default;
   BinaryHeap(BinaryHeap &&) = default;
   BinaryHeap &operator=(const BinaryHeap &) = default;
@@ -49,10 +63,56 @@ public:
     bubbleUp(m_container.size() - 1);
   }
 
+  /// Appends all elements of range. Batches are sifted up one by one, unless
+  /// they are at least HeapifyRatio times larger than the heap, then the heap
+  /// is restored with a bottom-up heapify over the ancestors of the appended
+  /// elements.
+  template <std::ranges::input_range R>
+    requires(std::convertible_to<std::ranges::range_reference_t<R>,
+                                 value_type>)
+  void push_range(R &&range) {
+    const size_type first = append(std::forward<R>(range));
+    const size_type size = m_container.size();
+    if (size - first < HeapifyRatio * first) {
+      for (size_type i = first; i < size; ++i) {
+        bubbleUp(i);
+      }
+    } else {
+      heapify(first);
+    }
+  }
+
+  /// Moves all elements of o into this heap in O(n + m) by appending them
+  /// and heapifying their ancestors. If o holds more elements and both
+  /// containers use equal allocators, the buffer of o is reused and the
+  /// elements of this heap are appended to it.
+  void meld(BinaryHeap &&o) {
+    if (this == &o || o.empty()) {
+      return;
+    }
+    if constexpr (requires { m_container.get_allocator(); }) {
+      if (o.size() > size() &&
+          alloc_equals(m_container.get_allocator(),
+                       o.m_container.get_allocator())) {
+        std::swap(m_container, o.m_container);
+      }
+    }
+    const auto end = std::ranges::end(o.m_container);
+    const auto begin = end - static_cast<difference_type>(o.size());
+    heapify(append(std::ranges::subrange(std::make_move_iterator(begin),
+                                         std::make_move_iterator(end))));
+    o.m_container.clear();
+  }
+
   void pop() {
-    std::swap(m_container.front(), m_container.back());
+    assert(!empty());
+    if (m_container.size() > 1) {
+      m_container.front() = std::move(m_container.back());
+    }
     m_container.pop_back();
-    bubbleDown(0);
+    if (!m_container.empty()) {
+      bubbleDown(0);
+    }
   }
   
   void reserve(std::size_t capacity) {
@@ -60,39 +120,101 @@ public:
   }
 
 private:
+  // With random keys a sift-up takes O(1) steps on average, heapify only pays
+  // off if the batch is much larger than the heap (measured for int).
+  static constexpr size_type HeapifyRatio = 4;
+
+  // Uninitialized storage for the element, which is sifted through the heap.
+  // Elements are relocated into the hole instead of being swapped.
+  union Hole {
+    Hole() {}
+    ~Hole() {}
+    value_type value;
+  };
+
+  // Appends all elements of range without restoring the heap property,
+  // returns the index of the first appended element.
+  template <typename R> size_type append(R &&range) {
+    const size_type first = m_container.size();
+    if constexpr (std::ranges::sized_range<R>) {
+      m_container.reserve(first + std::ranges::size(range));
+    }
+    for (auto &&value : range) {
+      m_container.push_back(std::forward<decltype(value)>(value));
+    }
+    return first;
+  }
+
+  // Restores the heap property, if [0, first) is a heap and [first, size())
+  // was appended. Sifts down all ancestors of appended elements, children
+  // before parents (Floyd's heapify for first = 0).
+  void heapify(size_type first) {
+    const size_type size = m_container.size();
+    if (first >= size || size < 2) {
+      return;
+    }
+    size_type lo = first == 0 ? 0 : (first - 1) / 2;
+    size_type hi = (size - 2) / 2;
+    while (true) {
+      for (size_type i = hi + 1; i-- > lo;) {
+        bubbleDown(i);
+      }
+      if (lo == 0) {
+        break;
+      }
+      hi = std::min(lo - 1, (hi - 1) / 2);
+      lo = (lo - 1) / 2;
+    }
+  }
+
   void bubbleUp(size_type index) {
-    std::size_t parent = (index - 1) / 2; // may underflow.
-    while (index != 0 &&
-           m_comparator(m_container[index], m_container[parent])) {
-      std::swap(m_container[index], m_container[parent]);
-      index = parent;
+    if (index == 0 ||
+        !m_comparator(m_container[index], m_container[(index - 1) / 2])) {
+      return;
     }
+    Hole hole;
+    relocate_at(&m_container[index], &hole.value);
+    do {
+      const size_type parent = (index - 1) / 2;
+      if (!m_comparator(hole.value, m_container[parent])) {
+        break;
+      }
+      relocate_at(&m_container[parent], &m_container[index]);
+      index = parent;
+    } while (index != 0);
+    relocate_at(&hole.value, &m_container[index]);
   }
 
   void bubbleDown(size_type index) {
-    while (index < m_container.size()) {
-      std::size_t left = 2 * index + 1;
-      std::size_t right = left + 1;
-      if (left >= m_container.size()) {
+    const size_type size = m_container.size();
+    Hole hole;
+    relocate_at(&m_container[index], &hole.value);
+    while (true) {
+      const size_type left = 2 * index + 1;
+      if (left >= size) {
         break;
       }
-      size_type next;
-      if (right < m_container.size()) {
-        next =
-            m_comparator(m_container[left], m_container[right]) ? left : right;
-      } else {
-        next = left;
+      const size_type right = left + 1;
+      size_type next = left;
+      if (right < size && m_comparator(m_container[right], m_container[left])) {
+        next = right;
       }
-      if (m_comparator(m_container[index], m_container[next])) {
+      if (!m_comparator(m_container[next], hole.value)) {
         break;
       }
-      std::swap(m_container[next], m_container[index]);
+      relocate_at(&m_container[next], &m_container[index]);
       index = next;
     }
+    relocate_at(&hole.value, &m_container[index]);
   }
 
   container m_container;
   [[no_unique_address]] comparator m_comparator;
 };
 
+template <typename T, typename Container, typename Compare>
+struct is_trivially_relocatable<BinaryHeap<T, Container, Compare>>
+    : std::bool_constant<is_trivially_relocatable_v<Container> &&
+                         is_trivially_relocatable_v<Compare>> {};
+
 } // namespace strobe
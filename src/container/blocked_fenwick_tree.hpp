@@ -0,0 +1,161 @@
+#pragma once
+
+#include "sync/cache_line.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/// Drop-in alternative to FenwickTree with B-ary blocks (a "wide" Fenwick
+/// tree). Level 0 stores for every element the prefix sum within its block
+/// of B elements, level h > 0 stores for every block of level h - 1 the sum
+/// of the preceding blocks within the same group of B blocks.
+/// prefix_query reads a single value per level, update adds delta to the
+/// (at most B) values of a single block per level, i.e. both touch one cache
+/// line per level and log_B(n) in total instead of log_2(n) scattered ones.
+/// By default a block fills exactly one cache line.
+template <typename T, typename Op = std::plus<T>,
+          typename InvOp = std::minus<T>,
+          std::size_t B = std::max<std::size_t>(
+              2, strobe::cache_line_size / sizeof(T))>
+class BlockedFenwickTree {
+  static_assert(B >= 2 && std::has_single_bit(B));
+  static constexpr std::size_t MaxLevels = 64;
+  static constexpr std::size_t Alignment =
+      std::max(alignof(T), strobe::cache_line_size);
+  // Levels start at multiples of B values, therefore blocks are aligned to
+  // their size (up to Alignment).
+  static constexpr std::size_t BlockAlignment =
+      std::has_single_bit(B * sizeof(T)) ? std::min(Alignment, B * sizeof(T))
+                                         : alignof(T);
+
+  // Integers are masked with a bitwise and, floating point values are
+  // selected, as multiplying by 0 turns an infinite or NaN delta into NaN.
+  using StepMaskType = std::conditional_t<std::is_integral_v<T>, T, bool>;
+  static constexpr std::array<StepMaskType, 2 * B> StepMask = [] {
+    std::array<StepMaskType, 2 * B> mask{};
+    for (std::size_t k = B; k < 2 * B; ++k) {
+      if constexpr (std::is_integral_v<T>) {
+        mask[k] = static_cast<T>(~std::make_unsigned_t<T>{});
+      } else {
+        mask[k] = true;
+      }
+    }
+    return mask;
+  }();
+
+public:
+  using size_type = size_t;
+
+  BlockedFenwickTree(size_type n, const Op &op = {}, const InvOp &invOp = {})
+      : m_op(op), m_invOp(invOp), m_size(n), m_levels(0), m_capacity(0) {
+    // Every level is padded to whole blocks, levels are added until a
+    // single block covers all blocks of the previous level.
+    size_type count = std::max<size_type>(n, 1);
+    while (true) {
+      m_offsets[m_levels++] = m_capacity;
+      const size_type blocks = (count + B - 1) / B;
+      m_capacity += blocks * B;
+      if (blocks <= 1) {
+        break;
+      }
+      count = blocks;
+    }
+    m_buffer = static_cast<T *>(
+        ::operator new(m_capacity * sizeof(T), std::align_val_t{Alignment}));
+    for (size_t i = 0; i < m_capacity; ++i) {
+      std::construct_at(m_buffer + i, T{});
+    }
+  }
+
+  ~BlockedFenwickTree() {
+    std::destroy_n(m_buffer, m_capacity);
+    ::operator delete(m_buffer, std::align_val_t{Alignment});
+  }
+
+  BlockedFenwickTree(const BlockedFenwickTree &) = delete;
+  BlockedFenwickTree &operator=(const BlockedFenwickTree &) = delete;
+
+  void update(size_t i, const T &delta) {
+    T *const buffer = m_buffer;
+    const size_type levels = m_levels;
+    // Level 0 holds inclusive prefix sums, i.e. i itself is updated.
+    add(buffer + i / B * B, i % B, delta);
+    for (size_t h = 1; h < levels; ++h) {
+      i /= B;
+      add(buffer + m_offsets[h] + i / B * B, i % B + 1, delta);
+    }
+  }
+
+  T prefix_query(size_t r) const {
+    T res = m_buffer[r];
+    for (size_t h = 1; h < m_levels; ++h) {
+      r /= B;
+      res = m_op(res, m_buffer[m_offsets[h] + r]);
+    }
+    return res;
+  }
+
+  T range_query(size_t l, size_t r) const {
+    if (l == 0) {
+      return prefix_query(r);
+    }
+    return m_invOp(prefix_query(r), prefix_query(l - 1));
+  }
+
+  T at(size_t i) const { return range_query(i, i); }
+
+  T operator[](size_t i) const { return at(i); }
+
+  void set(size_t i, const T &value) {
+    T cur = at(i);
+    T delta = m_invOp(value, cur);
+    update(i, delta);
+  }
+
+  size_t size() const { return m_size; }
+
+private:
+  // Adds delta to the values [first, B) of block, first might be B.
+  void add(T *block, size_t first, const T &delta) const {
+    if constexpr (std::is_arithmetic_v<T> && std::same_as<Op, std::plus<T>>) {
+      // Adding 0 to the values before first keeps the trip count constant,
+      // such that the loop is fully unrolled and vectorized. The mask is a
+      // window into a table of B zeros followed by B ones (all bits set for
+      // integers, true for floating point values), the window starting at
+      // B - first selects [first, B).
+      // Building the masked deltas separately keeps the table loads out of
+      // the loop over block, which is otherwise not vectorized.
+      const StepMaskType *mask = StepMask.data() + (B - first);
+      std::array<T, B> step;
+      for (size_t k = 0; k < B; ++k) {
+        if constexpr (std::is_integral_v<T>) {
+          step[k] = delta & mask[k];
+        } else {
+          step[k] = mask[k] ? delta : T{};
+        }
+      }
+      block = std::assume_aligned<BlockAlignment>(block);
+      for (size_t k = 0; k < B; ++k) {
+        block[k] += step[k];
+      }
+    } else {
+      for (size_t k = first; k < B; ++k) {
+        block[k] = m_op(block[k], delta);
+      }
+    }
+  }
+
+  [[no_unique_address]] Op m_op;
+  [[no_unique_address]] InvOp m_invOp;
+  size_type m_size;
+  size_type m_levels;
+  size_type m_capacity;
+  std::array<size_type, MaxLevels> m_offsets;
+  T *m_buffer;
+};
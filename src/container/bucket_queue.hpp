@@ -1,16 +1,28 @@
 #pragma once
 
-#include "container/vector.hpp"
+#include "memory/FreelistPool.hpp"
+#include <bit>
+#include <cassert>
 #include <concepts>
-#include <forward_list>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <memory>
-#include <ranges>
 #include <type_traits>
 
 namespace strobe {
 
+/// Monotone bucket queue (Dial's algorithm) for bounded integer keys.
+/// Elements with the same key are stored in a intrusive list, the lists form
+/// a ring indexed by key % keyCount. A occupancy bitmap over the ring allows
+/// to find the next non-empty bucket with a scan over 64 buckets at a time.
+///
+/// NOTE: The queue is monotone, all keys in the queue must be in the range
+/// [k, k + keyCount), where k is the key of the last popped element (initially
+/// 0). Pushing a key outside of this window into a empty queue moves the window
+/// to start at the pushed key.
 template <typename V, typename Key = std::identity>
   requires(std::is_invocable_v<const Key &, const V &> &&
            std::unsigned_integral<
@@ -34,6 +46,9 @@ private:
         : next(this), prev(this), value(std::forward<Args>(args)...) {}
   };
 
+  using Word = std::uint64_t;
+  static constexpr size_type WordBits = std::numeric_limits<Word>::digits;
+
 public:
   using K = std::remove_cvref_t<std::invoke_result_t<const Key &, const V &>>;
   using handle = void *;
@@ -42,53 +57,125 @@ public:
               const Key &key = {})
       : m_ringSize(static_cast<size_type>(keyCount)),
         m_ring(static_cast<Node **>(std::malloc(m_ringSize * sizeof(Node *)))),
-        m_minBucket(0), m_key(key) {
+        m_occupied(static_cast<Word *>(
+            std::malloc(wordCount(m_ringSize) * sizeof(Word)))),
+        m_minBucket(0), m_size(0), m_floorKey(0), m_key(key) {
     assert(m_ringSize != 0);
     assert(m_ring != nullptr);
+    assert(m_occupied != nullptr);
     std::memset(m_ring, 0, m_ringSize * sizeof(Node *));
+    std::memset(m_occupied, 0, wordCount(m_ringSize) * sizeof(Word));
+  }
+
+  ~BucketQueue() {
+    if constexpr (!std::is_trivially_destructible_v<V>) {
+      while (!empty()) {
+        pop();
+      }
+    }
+    std::free(m_ring);
+    std::free(m_occupied);
   }
 
+  BucketQueue(const BucketQueue &) = delete;
+  BucketQueue &operator=(const BucketQueue &) = delete;
+
   handle push(const V &value) { return emplace<const V &>(value); }
 
+  handle push(V &&value) { return emplace<V &&>(std::move(value)); }
+
   template <typename... Args> handle emplace(Args &&...args) {
     Node *node = emplace_node<Args...>(std::forward<Args>(args)...);
     insert_node(node);
+    ++m_size;
     return reinterpret_cast<handle>(node);
   }
 
-  void decrease_key(handle h, const V &v) {
-    decrease_key(h, [&](reference v) { v = v; });
+  void decrease_key(handle h, const V &value) {
+    decrease_key(h, [&](reference v) { v = value; });
   }
 
-  void decrease_key(handle h, V &&v) {
-    decrease_key(h, [&](reference v) { v = std::move(v); });
+  void decrease_key(handle h, V &&value) {
+    decrease_key(h, [&](reference v) { v = std::move(value); });
   }
 
   template <typename Fn>
     requires(std::is_invocable_v<Fn, V &>)
   void decrease_key(handle h, Fn &&fn) {
+    assert(h != nullptr);
     Node *node = reinterpret_cast<Node *>(h);
     linked_erase(node);
+    fn(node->value);
     insert_node(node);
   }
 
-  void pop() {}
+  void pop() {
+    assert(!empty());
+    Node *node = m_ring[m_minBucket];
+    m_floorKey = m_key(node->value);
+    linked_erase(node);
+    destroy_node(node);
+    if (--m_size != 0) {
+      m_minBucket = next_occupied(m_minBucket);
+    }
+  }
+
+  const V &top() const {
+    assert(!empty());
+    return m_ring[m_minBucket]->value;
+  }
+
+  bool empty() const { return m_size == 0; }
 
-  const V &top() {}
+  size_type size() const { return m_size; }
 
 private:
+  static constexpr size_type wordCount(size_type buckets) {
+    return (buckets + WordBits - 1) / WordBits;
+  }
+
+  // Returns the first occupied bucket in ring order, starting at (and
+  // including) bucket b. Requires a non-empty queue.
+  size_type next_occupied(size_type b) const {
+    assert(!empty());
+    size_type w = b / WordBits;
+    Word word = m_occupied[w] & (~Word(0) << (b % WordBits));
+    const size_type words = wordCount(m_ringSize);
+    while (word == 0) {
+      w = w + 1 == words ? 0 : w + 1;
+      word = m_occupied[w];
+    }
+    return w * WordBits + static_cast<size_type>(std::countr_zero(word));
+  }
+
   void insert_node(Node *node) {
-    size_type k = static_cast<size_type>(m_key(node->value));
-    size_type b = k % m_ringSize;
+    const K k = m_key(node->value);
+    if (empty() && (k < m_floorKey ||
+                     static_cast<size_type>(k - m_floorKey) >= m_ringSize)) {
+      m_floorKey = k;
+    }
+    assert(k >= m_floorKey);
+    assert(static_cast<size_type>(k - m_floorKey) < m_ringSize);
+    const size_type b = static_cast<size_type>(k) % m_ringSize;
     node->bucket = b;
     Node *bucket = m_ring[b];
     if (bucket == nullptr) {
       node->next = node;
       node->prev = node;
       m_ring[b] = node;
+      m_occupied[b / WordBits] |= Word(1) << (b % WordBits);
     } else {
       linked_insert_after(bucket, node);
     }
+    if (empty()) {
+      m_minBucket = b;
+    } else if (m_ring[m_minBucket] == nullptr) {
+      // decrease_key removed the last element of the minimum bucket.
+      m_minBucket =
+          next_occupied(static_cast<size_type>(m_floorKey) % m_ringSize);
+    } else if (k < m_key(m_ring[m_minBucket]->value)) {
+      m_minBucket = b;
+    }
   }
 
   void linked_insert_after(Node *list, Node *node) {
@@ -104,6 +191,8 @@ private:
     Node *next = node->next;
     if (prev == node) {
       m_ring[node->bucket] = nullptr;
+      m_occupied[node->bucket / WordBits] &=
+          ~(Word(1) << (node->bucket % WordBits));
     } else {
       prev->next = next;
       next->prev = prev;
@@ -113,7 +202,6 @@ private:
       }
     }
 #ifndef NDEBUG
-    m_ring[node->bucket] = std::numeric_limits<size_type>::max();
     node->prev = node;
     node->next = node;
 #endif
@@ -131,22 +219,25 @@ private:
   }
 
   Node *alloc_node() {
-    Node *node = static_cast<Node *>(std::malloc(sizeof(Node)));
+    Node *node =
+        static_cast<Node *>(m_pool.allocate(sizeof(Node), alignof(Node)));
     assert(node != nullptr);
     return node;
   }
 
-  void free_node(Node *node) { std::free(node); }
+  void free_node(Node *node) {
+    m_pool.deallocate(node, sizeof(Node), alignof(Node));
+  }
 
 private:
   size_type m_ringSize;
   Node **m_ring;
+  Word *m_occupied;
   size_type m_minBucket;
+  size_type m_size;
+  K m_floorKey;
+  FreelistResource<sizeof(Node), alignof(Node)> m_pool;
   [[no_unique_address]] Key m_key;
 };
 
-static void foo() {
-  BucketQueue<unsigned int> queue(10); //
-}
-
 } // namespace strobe
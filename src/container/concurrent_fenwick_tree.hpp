@@ -0,0 +1,161 @@
+#pragma once
+
+#include "sync/cache_line.hpp"
+#include "sync/thread_slot.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+/// Thread safe FenwickTree over arithmetic T with std::plus.
+/// update adds delta to every node on its path with a relaxed fetch_add,
+/// i.e. concurrent updates never block each other.
+/// The path of prefix_query(r) contains exactly one node of the path of
+/// every update(i) with i <= r (and none for i > r), a concurrent
+/// prefix_query therefore observes every update either completely or not at
+/// all.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+class AtomicFenwickTree {
+public:
+  using size_type = size_t;
+
+  explicit AtomicFenwickTree(size_type n) : m_size(n) {
+    m_buffer = static_cast<std::atomic<T> *>(
+        std::malloc((n + 1) * sizeof(std::atomic<T>)));
+    for (size_t i = 0; i <= n; ++i) {
+      std::construct_at(m_buffer + i, T{});
+    }
+  }
+
+  ~AtomicFenwickTree() {
+    std::destroy_n(m_buffer, m_size + 1);
+    std::free(m_buffer);
+  }
+
+  AtomicFenwickTree(const AtomicFenwickTree &) = delete;
+  AtomicFenwickTree &operator=(const AtomicFenwickTree &) = delete;
+
+  void update(size_t i, T delta) {
+    for (++i; i <= m_size; i += i & -i) {
+      m_buffer[i].fetch_add(delta, std::memory_order_relaxed);
+    }
+  }
+
+  T prefix_query(size_t r) const {
+    T res{};
+    for (++r; r > 0; r -= r & -r) {
+      res += m_buffer[r].load(std::memory_order_relaxed);
+    }
+    return res;
+  }
+
+  T range_query(size_t l, size_t r) const {
+    return prefix_query(r) - prefix_query(l - 1);
+  }
+
+  T at(size_t i) const { return range_query(i, i); }
+
+  T operator[](size_t i) const { return at(i); }
+
+  size_t size() const { return m_size; }
+
+private:
+  size_type m_size;
+  std::atomic<T> *m_buffer;
+};
+
+/// Thread safe FenwickTree over arithmetic T with std::plus, in which every
+/// thread updates its own tree. The threads with this_thread_live_slot() <
+/// shards own one shard each, which they update with plain (relaxed) loads
+/// and stores, all other threads share an additional shard, which is updated
+/// with fetch_add like AtomicFenwickTree. Queries sum over all shards and
+/// never block writers.
+/// Updates never touch a cache line written by another thread, but queries
+/// are shards + 1 times more expensive than with AtomicFenwickTree and the
+/// tree takes shards + 1 times its memory (each shard padded to whole cache
+/// lines). This pays off if updates are much more frequent than queries.
+/// NOTE: Threads only share the additional shard, if more than shards
+/// threads run at the same time, slots of exited threads are reused.
+template <typename T>
+  requires std::is_arithmetic_v<T>
+class ShardedFenwickTree {
+  static constexpr std::size_t NodesPerLine =
+      std::max<std::size_t>(1, strobe::cache_line_size / sizeof(T));
+
+public:
+  using size_type = size_t;
+
+  /// Creates one shard per thread, which is expected to update the tree
+  /// concurrently, and the shared shard.
+  explicit ShardedFenwickTree(
+      size_type n, std::size_t shards = std::thread::hardware_concurrency())
+      : m_size(n), m_shardCount(shards),
+        // Shards are padded to whole cache lines.
+        m_stride((n + 1 + NodesPerLine - 1) / NodesPerLine * NodesPerLine) {
+    m_buffer = static_cast<std::atomic<T> *>(::operator new(
+        (m_shardCount + 1) * m_stride * sizeof(std::atomic<T>),
+        std::align_val_t{strobe::cache_line_size}));
+    for (size_t i = 0; i < (m_shardCount + 1) * m_stride; ++i) {
+      std::construct_at(m_buffer + i, T{});
+    }
+  }
+
+  ~ShardedFenwickTree() {
+    std::destroy_n(m_buffer, (m_shardCount + 1) * m_stride);
+    ::operator delete(m_buffer, std::align_val_t{strobe::cache_line_size});
+  }
+
+  ShardedFenwickTree(const ShardedFenwickTree &) = delete;
+  ShardedFenwickTree &operator=(const ShardedFenwickTree &) = delete;
+
+  void update(size_t i, T delta) {
+    const std::size_t slot = strobe::this_thread_live_slot();
+    if (slot < m_shardCount) [[likely]] {
+      // Single writer, the store only has to be atomic for readers.
+      std::atomic<T> *shard = m_buffer + slot * m_stride;
+      for (++i; i <= m_size; i += i & -i) {
+        shard[i].store(shard[i].load(std::memory_order_relaxed) + delta,
+                       std::memory_order_relaxed);
+      }
+    } else {
+      std::atomic<T> *shard = m_buffer + m_shardCount * m_stride;
+      for (++i; i <= m_size; i += i & -i) {
+        shard[i].fetch_add(delta, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  T prefix_query(size_t r) const {
+    T res{};
+    for (std::size_t s = 0; s <= m_shardCount; ++s) {
+      const std::atomic<T> *shard = m_buffer + s * m_stride;
+      for (size_t j = r + 1; j > 0; j -= j & -j) {
+        res += shard[j].load(std::memory_order_relaxed);
+      }
+    }
+    return res;
+  }
+
+  T range_query(size_t l, size_t r) const {
+    return prefix_query(r) - prefix_query(l - 1);
+  }
+
+  T at(size_t i) const { return range_query(i, i); }
+
+  T operator[](size_t i) const { return at(i); }
+
+  size_t size() const { return m_size; }
+
+  std::size_t shard_count() const { return m_shardCount; }
+
+private:
+  size_type m_size;
+  std::size_t m_shardCount;
+  size_type m_stride;
+  std::atomic<T> *m_buffer;
+};
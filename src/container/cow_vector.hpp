@@ -0,0 +1,462 @@
+#pragma once
+
+#include "container/container_concepts.hpp"
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+namespace strobe {
+
+/// Copy-on-write vector. Copies share the elements and only increment a
+/// atomic reference count, which is stored in front of the elements.
+/// The first mutating call on a shared CowVector clones the elements.
+///
+/// Reads never synchronize, different CowVector's, which share the same
+/// elements, can be read, copied and destroyed concurrently (like a
+/// std::shared_ptr). Use the const member functions (e.g. cbegin) to avoid
+/// cloning, all non-const accessors have to assume that the returned
+/// reference is written to.
+/// NOTE: References obtained through non-const accessors must not be written
+/// to after the CowVector was copied, because the write would be visible to
+/// the copy.
+template <typename T, Allocator A = strobe::Mallocator> class CowVector {
+  using ATraits = AllocatorTraits<A>;
+
+  struct Header {
+    std::atomic<std::size_t> refcount;
+  };
+  static constexpr std::size_t DataOffset =
+      (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+  static constexpr std::size_t BlockAlign = std::max(alignof(Header), alignof(T));
+
+public:
+  using value_type = T;
+  using allocator_type = A;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = ATraits::template pointer<value_type>;
+  using const_pointer = ATraits::template const_pointer<value_type>;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // =================== Constructors =======================
+  explicit CowVector(const A &alloc = {})
+      : m_data(nullptr), m_size(0), m_capacity(0), m_allocator(alloc) {}
+
+  explicit CowVector(size_type size, const A &alloc = {})
+    requires std::is_default_constructible_v<T>
+      : CowVector(alloc) {
+    resize(size);
+  }
+
+  explicit CowVector(size_type size, const T &value, const A &alloc = {})
+      : CowVector(alloc) {
+    resize(size, value);
+  }
+
+  template <std::ranges::range Rg>
+    requires(std::same_as<std::ranges::range_value_t<Rg>, value_type>)
+  explicit CowVector(const Rg &rg, const A &alloc = {}) : CowVector(alloc) {
+    append(rg);
+  }
+
+  ~CowVector() { release(); }
+
+  CowVector(const CowVector &o)
+      : m_data(nullptr), m_size(0), m_capacity(0),
+        m_allocator(
+            ATraits::select_on_container_copy_construction(o.m_allocator)) {
+    share(o);
+  }
+
+  CowVector &operator=(const CowVector &o) {
+    if (this == &o) {
+      return *this;
+    }
+    release();
+    if (ATraits::propagate_on_container_copy_assignment) {
+      m_allocator = o.m_allocator;
+    }
+    share(o);
+    return *this;
+  }
+
+  CowVector(CowVector &&o) noexcept
+      : m_data(std::exchange(o.m_data, nullptr)),
+        m_size(std::exchange(o.m_size, 0)),
+        m_capacity(std::exchange(o.m_capacity, 0)),
+        m_allocator(std::move(o.m_allocator)) {}
+
+  CowVector &operator=(CowVector &&o) noexcept {
+    if (this == &o) {
+      return *this;
+    }
+    release();
+    if (ATraits::propagate_on_container_move_assignment ||
+        strobe::alloc_equals(m_allocator, o.m_allocator)) {
+      if (ATraits::propagate_on_container_move_assignment) {
+        m_allocator = std::move(o.m_allocator);
+      }
+      m_data = std::exchange(o.m_data, nullptr);
+      m_size = std::exchange(o.m_size, 0);
+      m_capacity = std::exchange(o.m_capacity, 0);
+    } else {
+      share(o);
+      o.release();
+    }
+    return *this;
+  }
+
+  // ===================== Vector-Interface ===================
+
+  const T &operator[](size_type i) const {
+    assert(i < m_size);
+    return m_data[i];
+  }
+
+  T &operator[](size_type i) {
+    assert(i < m_size);
+    detach();
+    return m_data[i];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_size == m_capacity || !isUnique()) [[unlikely]] {
+      // NOTE: args might reference a element of this vector, construct the
+      // new element before the elements are cloned or moved.
+      T value(std::forward<Args>(args)...);
+      makeUnique(m_size == m_capacity ? std::max<size_type>(m_capacity * 2, 1)
+                                      : m_capacity);
+      std::construct_at(m_data + m_size, std::move(value));
+    } else {
+      std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+    }
+    return m_data[m_size++];
+  }
+
+  void pop_back() {
+    assert(m_size != 0);
+    detach();
+    --m_size;
+    std::destroy_at(m_data + m_size);
+  }
+
+  void clear() {
+    if (isUnique()) {
+      std::destroy_n(m_data, m_size);
+      m_size = 0;
+    } else {
+      release();
+    }
+  }
+
+  size_type size() const { return m_size; }
+
+  size_type capacity() const { return m_capacity; }
+
+  bool empty() const { return m_size == 0; }
+
+  /// Amount of CowVector's, which share the elements with this one.
+  size_type use_count() const {
+    return m_data == nullptr
+               ? 0
+               : header()->refcount.load(std::memory_order_relaxed);
+  }
+
+  void reserve(size_type newCapacity) {
+    if (newCapacity > m_capacity) {
+      makeUnique(newCapacity);
+    }
+  }
+
+  void resize(size_type newSize, const T &value) {
+    if (newSize < m_size) {
+      shrink(newSize);
+    } else if (newSize > m_size) {
+      // NOTE: value might reference a element of this vector.
+      T copy = value;
+      makeUnique(std::max(newSize, m_capacity));
+      std::uninitialized_fill(m_data + m_size, m_data + newSize, copy);
+      m_size = newSize;
+    }
+  }
+
+  void resize(size_type newSize)
+    requires(std::is_default_constructible_v<T>)
+  {
+    if (newSize < m_size) {
+      shrink(newSize);
+    } else if (newSize > m_size) {
+      makeUnique(std::max(newSize, m_capacity));
+      std::uninitialized_value_construct(m_data + m_size, m_data + newSize);
+      m_size = newSize;
+    }
+  }
+
+  const T &back() const {
+    assert(m_size != 0);
+    return m_data[m_size - 1];
+  }
+  T &back() {
+    assert(m_size != 0);
+    detach();
+    return m_data[m_size - 1];
+  }
+
+  const T &front() const {
+    assert(m_size != 0);
+    return m_data[0];
+  }
+  T &front() {
+    assert(m_size != 0);
+    detach();
+    return m_data[0];
+  }
+
+  const T *data() const { return m_data; }
+  T *data() {
+    detach();
+    return m_data;
+  }
+
+  // ========================= Range insertion ==================
+  template <std::ranges::range R> void append(const R &range) {
+    insert(cend(), range);
+  }
+
+  template <std::ranges::range R>
+  iterator insert(const_iterator pos, const R &range) {
+    const size_type index = pos - cbegin();
+    const size_type n = rangeSize(range);
+    if (n != 0) {
+      makeUnique(m_size + n > m_capacity ? std::max(m_capacity * 2, m_size + n)
+                                         : m_capacity);
+      openGap(index, n);
+      if constexpr (std::ranges::contiguous_range<R> &&
+                    std::is_trivially_copyable_v<T>) {
+        std::memcpy(static_cast<void *>(m_data + index),
+                    std::ranges::data(range), n * sizeof(T));
+      } else {
+        std::uninitialized_copy_n(std::ranges::begin(range), n,
+                                  m_data + index);
+      }
+      m_size += n;
+    }
+    return m_data + index;
+  }
+
+  // ================= Range Interface ===============
+  // NOTE: The non-const overloads clone shared elements.
+  inline iterator begin() {
+    detach();
+    return m_data;
+  }
+  inline const_iterator begin() const { return m_data; }
+  inline iterator end() {
+    detach();
+    return m_data + m_size;
+  }
+  inline const_iterator end() const { return m_data + m_size; }
+  inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+  inline reverse_iterator rend() { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  inline const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  inline const_iterator cbegin() const { return m_data; }
+  inline const_iterator cend() const { return m_data + m_size; }
+  inline const_reverse_iterator crbegin() const {
+    return const_reverse_iterator(end());
+  }
+  inline const_reverse_iterator crend() const {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+  static size_type blockSize(size_type capacity) {
+    return DataOffset + capacity * sizeof(T);
+  }
+
+  static T *dataOf(void *block) {
+    return reinterpret_cast<T *>(static_cast<std::byte *>(block) + DataOffset);
+  }
+
+  static Header *headerOf(T *data) {
+    return reinterpret_cast<Header *>(reinterpret_cast<std::byte *>(data) -
+                                      DataOffset);
+  }
+
+  Header *header() const { return headerOf(m_data); }
+
+  template <typename R> static size_type rangeSize(const R &range) {
+    if constexpr (std::ranges::sized_range<R>) {
+      return std::ranges::size(range);
+    } else {
+      return static_cast<size_type>(std::ranges::distance(range));
+    }
+  }
+
+  // NOTE: No other CowVector can start sharing the elements while we are the
+  // only owner, therefore the result can't change until we copy ourself.
+  bool isUnique() const {
+    return m_data != nullptr &&
+           header()->refcount.load(std::memory_order_acquire) == 1;
+  }
+
+  // Returns a block with a refcount of 1 and the amount of T's which fit
+  // into it.
+  std::pair<T *, size_type> allocateBlock(size_type capacity) {
+    auto [block, bytes] = ATraits::allocate_at_least(
+        m_allocator, blockSize(capacity), BlockAlign);
+    assert(block != nullptr);
+    ::new (block) Header{1};
+    return {dataOf(block), (bytes - DataOffset) / sizeof(T)};
+  }
+
+  void deallocateBlock(T *data, size_type capacity) {
+    ATraits::deallocate(m_allocator, headerOf(data), blockSize(capacity),
+                        BlockAlign);
+  }
+
+  void share(const CowVector &o) {
+    if (o.m_data == nullptr) {
+      return;
+    }
+    if (strobe::alloc_equals(m_allocator, o.m_allocator)) {
+      o.header()->refcount.fetch_add(1, std::memory_order_relaxed);
+      m_data = o.m_data;
+      m_size = o.m_size;
+      m_capacity = o.m_capacity;
+    } else {
+      // The elements have to be released with the same allocator.
+      auto [data, capacity] = allocateBlock(o.m_size);
+      std::uninitialized_copy_n(o.m_data, o.m_size, data);
+      m_data = data;
+      m_size = o.m_size;
+      m_capacity = capacity;
+    }
+  }
+
+  // Drops our reference to the elements, the last owner destroys them.
+  void release() {
+    if (m_data == nullptr) {
+      return;
+    }
+    if (header()->refcount.fetch_sub(1, std::memory_order_release) == 1) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      std::destroy_n(m_data, m_size);
+      deallocateBlock(m_data, m_capacity);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_capacity = 0;
+  }
+
+  void detach() {
+    if (m_data != nullptr && !isUnique()) [[unlikely]] {
+      makeUnique(m_capacity);
+    }
+  }
+
+  // Ensures that we are the only owner of the elements and that at least
+  // minCapacity elements fit.
+  void makeUnique(size_type minCapacity) {
+    if (isUnique()) {
+      if (minCapacity > m_capacity) {
+        grow(minCapacity);
+      }
+      return;
+    }
+    auto [data, capacity] = allocateBlock(std::max(minCapacity, m_size));
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (m_size != 0) {
+        std::memcpy(static_cast<void *>(data), m_data, m_size * sizeof(T));
+      }
+    } else {
+      std::uninitialized_copy_n(m_data, m_size, data);
+    }
+    const size_type size = m_size;
+    release();
+    m_data = data;
+    m_size = size;
+    m_capacity = capacity;
+  }
+
+  // Grows the elements, which are not shared.
+  void grow(size_type newCapacity) {
+    if constexpr (ReAllocator<A> && is_trivially_relocatable_v<T>) {
+      void *block =
+          ATraits::reallocate(m_allocator, header(), blockSize(m_capacity),
+                              blockSize(newCapacity), BlockAlign);
+      assert(block != nullptr);
+      m_data = dataOf(block);
+      m_capacity = newCapacity;
+    } else {
+      auto [data, capacity] = allocateBlock(newCapacity);
+      relocate_n(m_data, m_size, data);
+      deallocateBlock(m_data, m_capacity);
+      m_data = data;
+      m_capacity = capacity;
+    }
+  }
+
+  void shrink(size_type newSize) {
+    detach();
+    std::destroy(m_data + newSize, m_data + m_size);
+    m_size = newSize;
+  }
+
+  // Shifts the elements [index, m_size) n slots to the back, leaving
+  // [index, index + n) uninitialized. Requires m_size + n <= m_capacity.
+  void openGap(size_type index, size_type n) {
+    assert(m_size + n <= m_capacity);
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(m_data + index + n), m_data + index,
+                   (m_size - index) * sizeof(T));
+    } else {
+      for (size_type i = m_size; i-- > index;) {
+        relocate_at(m_data + i, m_data + i + n);
+      }
+    }
+  }
+
+  T *m_data;
+  size_type m_size;
+  size_type m_capacity;
+  [[no_unique_address]] A m_allocator;
+};
+
+template <typename T, typename A>
+struct is_trivially_relocatable<CowVector<T, A>> : is_trivially_relocatable<A> {
+};
+
+static_assert(strobe::Container<CowVector<int>>);
+static_assert(strobe::RandomAccessContainer<CowVector<int>>);
+static_assert(!strobe::StackLikeContainer<CowVector<int>>);
+static_assert(!strobe::SetLikeContainer<CowVector<int>>);
+static_assert(!strobe::ContainerSupportsInsertion<CowVector<int>>);
+static_assert(
+    strobe::ContainerSupportsRangeInsertion<CowVector<int>, std::list<int>>);
+static_assert(std::ranges::contiguous_range<const CowVector<int>>);
+
+} // namespace strobe
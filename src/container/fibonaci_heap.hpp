@@ -1,7 +1,10 @@
 #pragma once
 
+#include "memory/AllocatorTraits.hpp"
 #include "memory/FreelistPool.hpp"
 #include "memory/Mallocator.hpp"
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <concepts>
@@ -10,24 +13,37 @@
 #include <iterator>
 #include <memory>
 #include <type_traits>
+#include <utility>
 namespace strobe {
 
-template <typename T, typename Compare = std::less<T>> class FibonaciHeap {
-private:
+namespace detail {
+
+template <typename T> struct FibonaciNode {
   using rank_t = std::uint64_t;
-  struct Node {
-    T data;
-    rank_t rank;
-    struct Node *parent;
-    struct Node *left;
-    struct Node *right;
-    struct Node *child;
-
-    template <typename... Args>
-    explicit Node(Args &&...args)
-        : data(std::forward<Args>(args)...), rank(0), parent(nullptr),
-          left(nullptr), right(nullptr), child(nullptr) {}
-  };
+  T data;
+  rank_t rank;
+  struct FibonaciNode *parent;
+  struct FibonaciNode *left;
+  struct FibonaciNode *right;
+  struct FibonaciNode *child;
+
+  template <typename... Args>
+  explicit FibonaciNode(Args &&...args)
+      : data(std::forward<Args>(args)...), rank(0), parent(nullptr),
+        left(nullptr), right(nullptr), child(nullptr) {}
+};
+
+} // namespace detail
+
+/// Nodes are allocated from A, by default a freelist pool owned by the heap,
+/// such that node churn never reaches the global allocator.
+template <typename T, typename Compare = std::less<T>,
+          Allocator A = FreelistResource<sizeof(detail::FibonaciNode<T>),
+                                         alignof(detail::FibonaciNode<T>)>>
+class FibonaciHeap {
+private:
+  using Node = detail::FibonaciNode<T>;
+  using rank_t = typename Node::rank_t;
 
 public:
   using comparator = Compare;
@@ -39,7 +55,69 @@ public:
 
   using handle = void *;
 
-  FibonaciHeap() : m_root(nullptr) {}
+  FibonaciHeap() : m_root(nullptr), m_allocator() {}
+  explicit FibonaciHeap(A allocator)
+      : m_root(nullptr), m_allocator(std::move(allocator)) {}
+
+  ~FibonaciHeap() { clear(); }
+
+  FibonaciHeap(const FibonaciHeap &) = delete;
+  FibonaciHeap &operator=(const FibonaciHeap &) = delete;
+
+  FibonaciHeap(FibonaciHeap &&o)
+      : m_root(std::exchange(o.m_root, nullptr)),
+        m_allocator(std::move(o.m_allocator)) {}
+
+  FibonaciHeap &operator=(FibonaciHeap &&o) {
+    if (this == &o) {
+      return *this;
+    }
+    clear();
+    m_root = std::exchange(o.m_root, nullptr);
+    m_allocator = std::move(o.m_allocator);
+    return *this;
+  }
+
+  /// Moves all elements of o into this heap by splicing the root lists in
+  /// O(1), handles of o stay valid. The pool of o is absorbed in O(log n)
+  /// (linear in its slab count). Other allocators must always compare equal.
+  void meld(FibonaciHeap &&o) {
+    if (this == &o || o.m_root == nullptr) {
+      return;
+    }
+    if constexpr (requires { m_allocator.absorb(std::move(o.m_allocator)); }) {
+      m_allocator.absorb(std::move(o.m_allocator));
+    } else {
+      static_assert(AllocatorTraits<A>::is_always_equal);
+    }
+    Node *root = std::exchange(o.m_root, nullptr);
+    if (m_root == nullptr) {
+      m_root = root;
+      return;
+    }
+    linked_splice(m_root, root);
+    if (comparator{}(root->data, m_root->data)) {
+      m_root = root;
+    }
+  }
+
+  /// Removes all elements. If the allocator can release all of its memory at
+  /// once (like the default pool) and T is trivially destructible, this does
+  /// not visit the nodes at all.
+  void clear() {
+    if constexpr (std::is_trivially_destructible_v<T> &&
+                  requires(A a) { a.release(); }) {
+      m_allocator.release();
+    } else {
+      if (m_root != nullptr) {
+        destroy_list(m_root);
+      }
+      if constexpr (requires(A a) { a.release(); }) {
+        m_allocator.release();
+      }
+    }
+    m_root = nullptr;
+  }
 
   template <typename... Args>
     requires(std::constructible_from<T, Args...>)
@@ -54,20 +132,17 @@ public:
   void pop() {
     assert(m_root != nullptr);
     Node *node = m_root;
+    Node *child = node->child;
 
-    // all all childs as new trees.
-    Node *child = m_root->child;
+    // delete min from forest, all childs become new trees.
+    linked_erase(node);
     if (child != nullptr) {
-      Node *curr = child;
-      do {
-        Node *next = curr->right;
-        push_tree(curr);
-        curr = next;
-      } while (curr != child);
+      if (m_root == nullptr) {
+        m_root = child;
+      } else {
+        linked_splice(m_root, child);
+      }
     }
-
-    // delete min from forest.
-    linked_erase(m_root);
     destroy_node(node);
     rebuild();
   }
@@ -101,50 +176,52 @@ public:
 
   void erase(handle h) {
     Node *node = reinterpret_cast<Node *>(h);
-    if (node == m_root) {
-      pop();
-    } else {
-      Node *child = node->child;
-      if (child != nullptr) {
-        Node *curr = child;
-        do {
-          Node *next = curr->right;
-          push_tree(curr);
-          curr = next;
-        } while (curr != child);
-      }
-      linked_erase(node);
-      destroy_node(node);
+    // Same as decreasing the key to -inf and popping it.
+    if (node->parent != nullptr) {
+      cut(node);
     }
+    m_root = node;
+    pop();
   }
 
 private:
   static constexpr rank_t MARK_BIT = rank_t(1) << (sizeof(rank_t) * 8 - 1);
+  // The degree of a node is bounded by log_phi(n) < 1.45 * 64.
+  static constexpr std::size_t MAX_DEGREE = 96;
   inline bool is_marked(const Node *node) { return node->rank & MARK_BIT; }
   inline void mark(Node *node) { node->rank |= MARK_BIT; }
+  inline void unmark(Node *node) { node->rank &= ~MARK_BIT; }
+  inline rank_t degree(const Node *node) { return node->rank & ~MARK_BIT; }
 
+  // Moves node into the root list. Cascading cut: a marked parent, which
+  // already lost a child, is cut as well, otherwise it gets marked.
   void cut(Node *node) {
-    linked_erase(node);
-    push_tree(node);
-  }
-
-  Node *union_trees(Node *lhs, Node *rhs) {
-    assert(lhs->parent == nullptr);
-    assert(rhs->parent == nullptr);
-    bool c = comparator{}(lhs->data, rhs->data);
-    Node *parent = c ? lhs : rhs;
-    Node *child = c ? rhs : lhs;
-    link(parent, child);
-    return parent;
+    Node *parent = node->parent;
+    assert(parent != nullptr);
+    while (true) {
+      linked_erase(node);
+      --parent->rank;
+      unmark(node);
+      push_tree(node);
+      if (parent->parent == nullptr) {
+        break;
+      }
+      if (!is_marked(parent)) {
+        mark(parent);
+        break;
+      }
+      node = parent;
+      parent = node->parent;
+    }
   }
 
+  // Makes child, the root of a tree with the same degree, a child of parent.
   void link(Node *parent, Node *child) {
     assert(parent != nullptr);
     assert(child != nullptr);
-    assert(parent->parent == nullptr);
-    assert(child->parent == nullptr);
-    linked_erase(child);
+    unmark(child);
     linked_insert_child(parent, child);
+    ++parent->rank;
   }
 
   void push_tree(Node *node) {
@@ -197,6 +274,16 @@ private:
     }
   }
 
+  // Joins the circular lists of a and b.
+  void linked_splice(Node *a, Node *b) {
+    Node *aLast = a->left;
+    Node *bLast = b->left;
+    aLast->right = b;
+    b->left = aLast;
+    bLast->right = a;
+    a->left = bLast;
+  }
+
   void linked_insert_after(Node *pos, Node *node) {
     assert(pos != nullptr);
     Node *right = pos->right;
@@ -207,16 +294,39 @@ private:
     node->right = right;
   }
 
+  // Consolidation: links roots of equal degree until all degrees in the root
+  // list are distinct, then rebuilds the root list and finds the new min.
   void rebuild() {
-    // pairwise union, implicitly finds the min.
     if (m_root == nullptr) {
       return;
     }
-    Node *head = m_root;
-    Node *next = head->right;
-    while (head != next) {
-      head = union_trees(head, next);
-      next = head->right;
+    std::array<Node *, MAX_DEGREE> byDegree{};
+    rank_t maxDegree = 0;
+    // Break the circular root list, every tree is reinserted afterwards.
+    Node *curr = m_root;
+    curr->left->right = nullptr;
+    m_root = nullptr;
+    while (curr != nullptr) {
+      Node *next = curr->right;
+      curr->parent = nullptr;
+      rank_t d = degree(curr);
+      assert(d < MAX_DEGREE);
+      while (byDegree[d] != nullptr) {
+        Node *other = std::exchange(byDegree[d], nullptr);
+        if (comparator{}(other->data, curr->data)) {
+          std::swap(curr, other);
+        }
+        link(curr, other);
+        ++d;
+      }
+      byDegree[d] = curr;
+      maxDegree = std::max(maxDegree, d);
+      curr = next;
+    }
+    for (rank_t d = 0; d <= maxDegree; ++d) {
+      if (byDegree[d] != nullptr) {
+        push_tree(byDegree[d]);
+      }
     }
   }
 
@@ -229,7 +339,8 @@ private:
   }
 
   Node *alloc_node() {
-    Node *node = static_cast<Node *>(std::malloc(sizeof(Node)));
+    Node *node = static_cast<Node *>(
+        AllocatorTraits<A>::allocate(m_allocator, sizeof(Node), alignof(Node)));
     assert(node != nullptr);
     return node;
   }
@@ -239,11 +350,31 @@ private:
     free_node(node);
   }
 
-  void free_node(Node *node) { std::free(node); }
+  void free_node(Node *node) {
+    AllocatorTraits<A>::deallocate(m_allocator, node, sizeof(Node),
+                                   alignof(Node));
+  }
+
+  // Destroys all trees in the circular sibling list of node. Without
+  // recursion: the circle is broken up and the children of every destroyed
+  // node are spliced in front of the remaining list.
+  void destroy_list(Node *node) {
+    node->left->right = nullptr;
+    Node *curr = node;
+    while (curr != nullptr) {
+      Node *next = curr->right;
+      if (Node *child = curr->child; child != nullptr) {
+        child->left->right = next;
+        next = child;
+      }
+      destroy_node(curr);
+      curr = next;
+    }
+  }
 
-public:
 private:
   Node *m_root;
+  [[no_unique_address]] A m_allocator;
 };
 
 } // namespace strobe
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "container/select_child.hpp"
+#include "container/vector.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace strobe {
+
+/// Addressable K-ary min-heap (w.r.t. Compare) over dense ids in [0, n).
+/// Keys and ids are stored in two parallel arrays, a third array maps every
+/// id to its position in the heap (or npos), which is updated while sifting.
+/// Therefore decrease_key and erase are O(log_K n) without any per element
+/// allocation, the id space grows on demand.
+template <typename Key, std::size_t K = 4, typename Compare = std::less<Key>>
+class IndexedKAryHeap {
+  static_assert(K >= 2);
+
+public:
+  using comparator = Compare;
+  using key_type = Key;
+  using id_type = std::size_t;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+  IndexedKAryHeap()
+    requires(std::is_default_constructible_v<comparator>)
+      : m_comparator() {}
+  explicit IndexedKAryHeap(size_type idCount, const Compare &compare = {})
+      : m_positions(idCount, npos), m_comparator(compare) {}
+
+  bool empty() const { return m_keys.empty(); }
+
+  size_type size() const { return m_keys.size(); }
+
+  const key_type &top() const {
+    assert(!empty());
+    return m_keys.front();
+  }
+
+  id_type top_id() const {
+    assert(!empty());
+    return m_ids.front();
+  }
+
+  bool contains(id_type id) const {
+    return id < m_positions.size() && m_positions[id] != npos;
+  }
+
+  const key_type &key(id_type id) const {
+    assert(contains(id));
+    return m_keys[m_positions[id]];
+  }
+
+  void push(id_type id, const key_type &key) {
+    assert(!contains(id));
+    if (id >= m_positions.size()) {
+      m_positions.resize(std::max(id + 1, m_positions.size() * 2), npos);
+    }
+    m_keys.push_back(key);
+    m_ids.push_back(id);
+    m_positions[id] = m_keys.size() - 1;
+    bubbleUp(m_keys.size() - 1);
+  }
+
+  /// Requires that key does not compare greater than the current key of id.
+  void decrease_key(id_type id, const key_type &key) {
+    assert(contains(id));
+    const size_type index = m_positions[id];
+    assert(!m_comparator(m_keys[index], key));
+    m_keys[index] = key;
+    bubbleUp(index);
+  }
+
+  /// Pushes id if it is not contained, otherwise sets its key to key.
+  void push_or_update(id_type id, const key_type &key) {
+    if (!contains(id)) {
+      push(id, key);
+      return;
+    }
+    const size_type index = m_positions[id];
+    const bool decrease = m_comparator(key, m_keys[index]);
+    m_keys[index] = key;
+    if (decrease) {
+      bubbleUp(index);
+    } else {
+      bubbleDown(index);
+    }
+  }
+
+  void pop() {
+    assert(!empty());
+    eraseAt(0);
+  }
+
+  void erase(id_type id) {
+    assert(contains(id));
+    eraseAt(m_positions[id]);
+  }
+
+  void clear() {
+    for (const id_type id : m_ids) {
+      m_positions[id] = npos;
+    }
+    m_keys.clear();
+    m_ids.clear();
+  }
+
+  /// Reserves space for ids in [0, idCount).
+  void reserve(size_type idCount) {
+    m_keys.reserve(idCount);
+    m_ids.reserve(idCount);
+    if (idCount > m_positions.size()) {
+      m_positions.resize(idCount, npos);
+    }
+  }
+
+private:
+  void eraseAt(size_type index) {
+    m_positions[m_ids[index]] = npos;
+    const size_type last = m_keys.size() - 1;
+    if (index != last) {
+      m_keys[index] = std::move(m_keys.back());
+      m_ids[index] = m_ids.back();
+      m_positions[m_ids[index]] = index;
+    }
+    m_keys.pop_back();
+    m_ids.pop_back();
+    if (index != last) {
+      // The moved element can violate the heap property in both directions.
+      if (index != 0 && m_comparator(m_keys[index], m_keys[(index - 1) / K])) {
+        bubbleUp(index);
+      } else {
+        bubbleDown(index);
+      }
+    }
+  }
+
+  // Uninitialized storage for the key, which is sifted through the heap.
+  union Hole {
+    Hole() {}
+    ~Hole() {}
+    key_type value;
+  };
+
+  void moveTo(size_type from, size_type to) {
+    relocate_at(&m_keys[from], &m_keys[to]);
+    m_ids[to] = m_ids[from];
+    m_positions[m_ids[to]] = to;
+  }
+
+  void bubbleUp(size_type index) {
+    if (index == 0 || !m_comparator(m_keys[index], m_keys[(index - 1) / K])) {
+      return;
+    }
+    Hole hole;
+    relocate_at(&m_keys[index], &hole.value);
+    const id_type id = m_ids[index];
+    do {
+      const size_type parent = (index - 1) / K;
+      if (!m_comparator(hole.value, m_keys[parent])) {
+        break;
+      }
+      moveTo(parent, index);
+      index = parent;
+    } while (index != 0);
+    relocate_at(&hole.value, &m_keys[index]);
+    m_ids[index] = id;
+    m_positions[id] = index;
+  }
+
+  void bubbleDown(size_type index) {
+    const size_type size = m_keys.size();
+    Hole hole;
+    relocate_at(&m_keys[index], &hole.value);
+    const id_type id = m_ids[index];
+    while (true) {
+      const size_type left = index * K + 1;
+      if (left >= size) {
+        break;
+      }
+      size_type next = left;
+      if (left + K <= size) {
+        next += select_child<key_type, K>(&m_keys[left], m_comparator);
+      } else {
+        next = minChild(left, size);
+      }
+      if (!m_comparator(m_keys[next], hole.value)) {
+        break;
+      }
+      moveTo(next, index);
+      index = next;
+    }
+    relocate_at(&hole.value, &m_keys[index]);
+    m_ids[index] = id;
+    m_positions[id] = index;
+  }
+
+  size_type minChild(size_type left, size_type end) const {
+    size_type next = left;
+    for (size_type n = left + 1; n < end; ++n) {
+      if (m_comparator(m_keys[n], m_keys[next])) {
+        next = n;
+      }
+    }
+    return next;
+  }
+
+  strobe::Vector<key_type> m_keys;
+  strobe::Vector<id_type> m_ids;
+  // id -> index into m_keys / m_ids, npos if id is not contained.
+  strobe::Vector<size_type> m_positions;
+  [[no_unique_address]] comparator m_comparator;
+};
+
+template <typename Key, std::size_t K, typename Compare>
+struct is_trivially_relocatable<IndexedKAryHeap<Key, K, Compare>>
+    : std::bool_constant<is_trivially_relocatable_v<strobe::Vector<Key>> &&
+                         is_trivially_relocatable_v<Compare>> {};
+
+} // namespace strobe
@@ -1,13 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <ranges>
+#include "container/select_child.hpp"
 #include "container/vector.hpp"
+#include "memory/AlignedAllocator.hpp"
+#include "sync/cache_line.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
 
 namespace strobe {
 
+/// Implicit K-ary min-heap (w.r.t. Compare) stored in Container.
+/// With CacheAligned the root is stored at index K - 1 behind K - 1 default
+/// constructed padding slots, such that the children of every node start at a
+/// multiple of K. If the container is cache line aligned and K * sizeof(T)
+/// divides (or is a multiple of) the cache line size, the children of a node
+/// never straddle two cache lines, i.e. a sift-down costs one cache miss per
+/// level. See CacheAlignedKAryHeap.
 template <typename T, std::size_t K, typename Container = strobe::Vector<T>,
-          typename Compare = std::less<typename Container::value_type>>
+          typename Compare = std::less<typename Container::value_type>,
+          bool CacheAligned = false>
 class KAryHeap {
 public:
   using container = Container;
@@ -18,73 +35,232 @@ public:
   using size_type = typename Container::size_type;
   using difference_type = typename Container::difference_type;
 
+private:
+  static constexpr size_type Pad = CacheAligned ? K - 1 : 0;
+  static_assert(!CacheAligned || std::is_default_constructible_v<value_type>);
+
+public:
   KAryHeap()
     requires(std::is_default_constructible_v<container> &&
              std::is_default_constructible_v<comparator>)
       : m_container(), m_comparator() {}
+  /// Builds the heap from range with a bottom-up heapify in O(n).
+  template <std::ranges::input_range R>
+    requires(std::convertible_to<std::ranges::range_reference_t<R>,
+                                 value_type> &&
+             std::is_default_constructible_v<container>)
+  explicit KAryHeap(R &&range, const Compare &compare = {})
+      : m_container(), m_comparator(compare) {
+    push_range(std::forward<R>(range));
+  }
   KAryHeap(const KAryHeap &) = default;
   KAryHeap(KAryHeap &&) = default;
   KAryHeap &operator=(const KAryHeap &) = default;
   KAryHeap &operator=(KAryHeap &&) = default;
 
-  const_reference top() const { return m_container.front(); }
+  const_reference top() const {
+    assert(!empty());
+    return m_container[Pad];
+  }
 
-  bool empty() const { return std::ranges::empty(m_container); }
+  bool empty() const { return size() == 0; }
 
-  size_type size() const { return std::ranges::size(m_container); }
+  size_type size() const {
+    const size_type size = std::ranges::size(m_container);
+    // NOTE: A moved from container might have lost its padding.
+    return size > Pad ? size - Pad : 0;
+  }
 
   void push(const value_type &lvalue) {
+    pad();
     m_container.push_back(lvalue);
-    bubbleUp(m_container.size() - 1);
+    bubbleUp(size() - 1);
   }
 
   void push(value_type &&rvalue) {
+    pad();
     m_container.push_back(std::move(rvalue));
-    bubbleUp(m_container.size() - 1);
+    bubbleUp(size() - 1);
   }
 
   template <typename... Args> void emplace(Args &&...args) {
+    pad();
     m_container.template emplace_back<Args...>(std::forward<Args>(args)...);
-    bubbleUp(m_container.size() - 1);
+    bubbleUp(size() - 1);
+  }
+
+  /// Appends all elements of range. Small batches are sifted up one by one,
+  /// larger batches restore the heap with a bottom-up heapify over the
+  /// ancestors of the appended elements.
+  template <std::ranges::input_range R>
+    requires(std::convertible_to<std::ranges::range_reference_t<R>,
+                                 value_type>)
+  void push_range(R &&range) {
+    pad();
+    const size_type first = size();
+    if constexpr (std::ranges::sized_range<R>) {
+      m_container.reserve(std::ranges::size(m_container) +
+                          std::ranges::size(range));
+    }
+    for (auto &&value : range) {
+      m_container.push_back(std::forward<decltype(value)>(value));
+    }
+    const size_type batch = size() - first;
+    if (batch < depth(size())) {
+      for (size_type i = first; i < size(); ++i) {
+        bubbleUp(i);
+      }
+    } else {
+      heapify(first);
+    }
+  }
+
+  /// Moves all elements of o into this heap in O(n + m) with push_range. If
+  /// o holds more elements and both containers use equal allocators, the
+  /// buffer of o is reused and the elements of this heap are appended to it.
+  void meld(KAryHeap &&o) {
+    if (this == &o || o.empty()) {
+      return;
+    }
+    if constexpr (requires { m_container.get_allocator(); }) {
+      if (o.size() > size() &&
+          alloc_equals(m_container.get_allocator(),
+                       o.m_container.get_allocator())) {
+        std::swap(m_container, o.m_container);
+      }
+    }
+    const auto end = std::ranges::end(o.m_container);
+    const auto begin = end - static_cast<difference_type>(o.size());
+    push_range(std::ranges::subrange(std::make_move_iterator(begin),
+                                     std::make_move_iterator(end)));
+    o.m_container.clear();
   }
 
   void pop() {
-    std::swap(m_container.front(), m_container.back());
+    assert(!empty());
+    if (size() > 1) {
+      at(0) = std::move(m_container.back());
+    }
     m_container.pop_back();
-    bubbleDown(0);
+    if (!empty()) {
+      bubbleDown(0);
+    }
+  }
+
+  /// Like pop, but moves the top element out instead of destroying it.
+  value_type pop_top() {
+    assert(!empty());
+    value_type top = std::move(at(0));
+    pop();
+    return top;
   }
 
   void reserve(std::size_t capacity) {
-    m_container.reserve(capacity);
+    m_container.reserve(capacity + Pad);
   }
 
 private:
+  void pad() {
+    if constexpr (Pad != 0) {
+      if (std::ranges::size(m_container) < Pad) [[unlikely]] {
+        m_container.resize(Pad);
+      }
+    }
+  }
+
+  // Approximation of log_K(size), i.e. the height of the heap.
+  static constexpr size_type depth(size_type size) {
+    return static_cast<size_type>(std::bit_width(size)) /
+           static_cast<size_type>(std::bit_width(K - 1));
+  }
+
+  // Restores the heap property, if [0, first) is a heap and [first, size())
+  // was appended. Sifts down all ancestors of appended elements, children
+  // before parents (Floyd's heapify for first = 0).
+  void heapify(size_type first) {
+    const size_type size = this->size();
+    if (first >= size || size < 2) {
+      return;
+    }
+    size_type lo = first == 0 ? 0 : (first - 1) / K;
+    size_type hi = (size - 2) / K;
+    while (true) {
+      for (size_type i = hi + 1; i-- > lo;) {
+        bubbleDown(i);
+      }
+      if (lo == 0) {
+        break;
+      }
+      hi = std::min(lo - 1, (hi - 1) / K);
+      lo = (lo - 1) / K;
+    }
+  }
+
+  reference at(size_type i) { return m_container[i + Pad]; }
+  const_reference at(size_type i) const { return m_container[i + Pad]; }
+
+  // Uninitialized storage for the element, which is sifted through the heap.
+  // Elements are relocated into the hole instead of being swapped.
+  union Hole {
+    Hole() {}
+    ~Hole() {}
+    value_type value;
+  };
+
   void bubbleUp(size_type index) {
-    std::size_t parent = (index - 1) / K; // may underflow.
-    while (index != 0 &&
-           m_comparator(m_container[index], m_container[parent])) {
-      std::swap(m_container[index], m_container[parent]);
-      index = parent;
+    if (index == 0 || !m_comparator(at(index), at((index - 1) / K))) {
+      return;
     }
+    Hole hole;
+    relocate_at(&at(index), &hole.value);
+    do {
+      const size_type parent = (index - 1) / K;
+      if (!m_comparator(hole.value, at(parent))) {
+        break;
+      }
+      relocate_at(&at(parent), &at(index));
+      index = parent;
+    } while (index != 0);
+    relocate_at(&hole.value, &at(index));
   }
 
   void bubbleDown(size_type index) {
-    while (index < m_container.size()) {
-      size_type left = index * K + 1;
-      size_type right = left + K - 1;
-      size_type end = std::min(right, m_container.size() - 1);
-      size_type next = index;
-      for (size_type n = left; n < end; ++n) {
-        if (m_comparator(m_container[n], m_container[next])) {
-          next = n;
+    const size_type size = this->size();
+    Hole hole;
+    relocate_at(&at(index), &hole.value);
+    while (true) {
+      const size_type left = index * K + 1;
+      if (left >= size) {
+        break;
+      }
+      size_type next = left;
+      if constexpr (std::ranges::contiguous_range<container> &&
+                    simd_select_child_v<value_type, K, comparator>) {
+        if (left + K <= size) {
+          next += select_child<value_type, K>(&at(left), m_comparator);
+        } else {
+          next = minChild(left, size);
         }
+      } else {
+        next = minChild(left, std::min(left + K, size));
       }
-      if (next == index) {
+      if (!m_comparator(at(next), hole.value)) {
         break;
       }
-      std::swap(m_container[next], m_container[index]);
+      relocate_at(&at(next), &at(index));
       index = next;
     }
+    relocate_at(&hole.value, &at(index));
+  }
+
+  size_type minChild(size_type left, size_type end) const {
+    size_type next = left;
+    for (size_type n = left + 1; n < end; ++n) {
+      if (m_comparator(at(n), at(next))) {
+        next = n;
+      }
+    }
+    return next;
   }
 
 private:
@@ -92,4 +268,18 @@ private:
   [[no_unique_address]] comparator m_comparator;
 };
 
+template <typename T, std::size_t K, typename Container, typename Compare,
+          bool CacheAligned>
+struct is_trivially_relocatable<
+    KAryHeap<T, K, Container, Compare, CacheAligned>>
+    : std::bool_constant<is_trivially_relocatable_v<Container> &&
+                         is_trivially_relocatable_v<Compare>> {};
+
+/// KAryHeap, which stores the children of a node in a single cache line.
+template <typename T, std::size_t K, typename Compare = std::less<T>,
+          Allocator A = strobe::Mallocator>
+using CacheAlignedKAryHeap =
+    KAryHeap<T, K, strobe::Vector<T, AlignedAllocator<A, cache_line_size>>,
+             Compare, true>;
+
 } // namespace strobe
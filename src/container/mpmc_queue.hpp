@@ -0,0 +1,169 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "sync/cache_line.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace strobe {
+
+/// Bounded lock-free multi-producer / multi-consumer FIFO queue (Vyukov).
+/// Every cell of the ring buffer carries a sequence number, which tells
+/// producers and consumers in which round the cell may be written or read.
+/// A thread claims a cell with a single CAS on the enqueue (or dequeue)
+/// counter and publishes it by bumping the sequence number of the cell,
+/// i.e. producers and consumers only contend among themselves.
+///
+/// enqueue and dequeue wait (yield) until the ring has space or elements.
+template <typename T, Allocator A = strobe::Mallocator> class MpmcQueue {
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    union {
+      T value;
+    };
+    Cell() {}
+    ~Cell() {}
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = A;
+
+  static constexpr size_type DefaultCapacity = 1024;
+
+  /// Capacity is rounded up to the next power of two.
+  explicit MpmcQueue(size_type capacity = DefaultCapacity,
+                     const A &allocator = {})
+      : m_cells(nullptr),
+        m_mask(std::bit_ceil(std::max<size_type>(capacity, 2)) - 1),
+        m_allocator(allocator) {
+    m_cells = static_cast<Cell *>(AllocatorTraits<A>::allocate(
+        m_allocator, (m_mask + 1) * sizeof(Cell), BufferAlignment));
+    assert(m_cells != nullptr);
+    for (size_type i = 0; i <= m_mask; ++i) {
+      std::construct_at(m_cells + i);
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MpmcQueue() {
+    while (try_dequeue().has_value()) {
+    }
+    std::destroy_n(m_cells, m_mask + 1);
+    AllocatorTraits<A>::deallocate(m_allocator, m_cells,
+                                   (m_mask + 1) * sizeof(Cell),
+                                   BufferAlignment);
+  }
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+  MpmcQueue(MpmcQueue &&) = delete;
+  MpmcQueue &operator=(MpmcQueue &&) = delete;
+
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    size_type pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &m_cells[pos & m_mask];
+      const size_type sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The cell still holds the element of the previous round.
+        return false;
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    std::construct_at(&cell->value, std::forward<Args>(args)...);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_enqueue(const value_type &v) { return try_emplace(v); }
+  bool try_enqueue(value_type &&v) { return try_emplace(std::move(v)); }
+
+  void enqueue(const value_type &v) {
+    while (!try_enqueue(v)) {
+      std::this_thread::yield();
+    }
+  }
+  void enqueue(value_type &&v) {
+    while (!try_enqueue(std::move(v))) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::optional<value_type> try_dequeue() {
+    size_type pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell = &m_cells[pos & m_mask];
+      const size_type sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+      if (diff == 0) {
+        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The cell was not written in this round yet.
+        return std::nullopt;
+      } else {
+        pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    std::optional<value_type> value{std::in_place, std::move(cell->value)};
+    std::destroy_at(&cell->value);
+    cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return value;
+  }
+
+  value_type dequeue() {
+    while (true) {
+      if (std::optional<value_type> value = try_dequeue()) {
+        return std::move(*value);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /// Snapshot, only exact if no other thread modifies the queue.
+  size_type size() const {
+    const size_type dequeued = m_dequeuePos.load(std::memory_order_acquire);
+    const size_type enqueued = m_enqueuePos.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_type capacity() const { return m_mask + 1; }
+
+  allocator_type get_allocator() const { return m_allocator; }
+
+private:
+  static constexpr std::size_t BufferAlignment =
+      std::max(alignof(Cell), cache_line_size);
+
+  // Read only.
+  Cell *m_cells;
+  size_type m_mask;
+  [[no_unique_address]] A m_allocator;
+  alignas(cache_line_size) std::atomic<size_type> m_enqueuePos{0};
+  alignas(cache_line_size) std::atomic<size_type> m_dequeuePos{0};
+};
+
+} // namespace strobe
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "memory/FreelistPool.hpp"
+#include "sync/cache_line.hpp"
+#include "sync/spin_lock.hpp"
+#include "sync/thread_slot.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace strobe {
+
+namespace detail {
+
+template <typename T> struct MpscNode {
+  std::atomic<MpscNode *> next;
+  // Index of the pool, which the node was allocated from.
+  std::uint32_t pool;
+  union {
+    T value;
+  };
+  MpscNode() : next(nullptr), pool(0) {}
+  ~MpscNode() {}
+};
+
+} // namespace detail
+
+/// Unbounded multi-producer / single-consumer FIFO queue (Vyukov).
+/// The queue is a singly linked list of nodes, which starts with a stub.
+/// Producers append with a single exchange on the head and never wait for
+/// each other, the consumer pops from the tail without any atomic RMW.
+/// NOTE: Between the exchange and the link of its node a producer blocks
+/// the consumer from seeing any later element, try_dequeue may therefore
+/// spuriously fail while a producer is preempted in that window.
+///
+/// Nodes are allocated from FreelistResources, which are selected by
+/// this_thread_slot() % SlotCount (see CachingBuddyResource). A node is
+/// returned to the pool it came from, every pool is guarded by a SpinLock,
+/// which is only contended by its producer and the consumer.
+///
+/// enqueue may be called by any thread, try_dequeue and dequeue only by a
+/// single consumer at a time.
+template <typename T, std::size_t SlotCount = 64> class MpscQueue {
+  using Node = detail::MpscNode<T>;
+
+  struct alignas(cache_line_size) Pool {
+    SpinLock lock;
+    FreelistResource<sizeof(Node), alignof(Node)> freelist;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  MpscQueue() : m_tail(&m_stub), m_head(&m_stub) {}
+
+  ~MpscQueue() {
+    while (try_dequeue().has_value()) {
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+  MpscQueue(MpscQueue &&) = delete;
+  MpscQueue &operator=(MpscQueue &&) = delete;
+
+  template <typename... Args> void emplace(Args &&...args) {
+    Node *node = allocate_node();
+    std::construct_at(&node->value, std::forward<Args>(args)...);
+    link(node);
+  }
+  void enqueue(const value_type &v) { emplace(v); }
+  void enqueue(value_type &&v) { emplace(std::move(v)); }
+
+  std::optional<value_type> try_dequeue() {
+    Node *tail = m_tail;
+    Node *next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    // next becomes the new stub, its value is moved out.
+    std::optional<value_type> value{std::in_place, std::move(next->value)};
+    std::destroy_at(&next->value);
+    m_tail = next;
+    if (tail != &m_stub) {
+      free_node(tail);
+    }
+    return value;
+  }
+
+  value_type dequeue() {
+    while (true) {
+      if (std::optional<value_type> value = try_dequeue()) {
+        return std::move(*value);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /// Only meaningful for the consumer, might spuriously return true while a
+  /// producer is linking its node.
+  bool empty() const {
+    return m_tail->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  void link(Node *node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  Node *allocate_node() {
+    const std::uint32_t index =
+        static_cast<std::uint32_t>(this_thread_slot() % SlotCount);
+    Pool &pool = m_pools[index];
+    void *raw;
+    {
+      std::lock_guard lock{pool.lock};
+      raw = pool.freelist.allocate(sizeof(Node), alignof(Node));
+    }
+    assert(raw != nullptr);
+    Node *node = std::construct_at(static_cast<Node *>(raw));
+    node->pool = index;
+    return node;
+  }
+
+  void free_node(Node *node) {
+    Pool &pool = m_pools[node->pool];
+    std::destroy_at(node);
+    std::lock_guard lock{pool.lock};
+    pool.freelist.deallocate(node, sizeof(Node), alignof(Node));
+  }
+
+  // Written by the consumer.
+  alignas(cache_line_size) Node *m_tail;
+  // Written by all producers.
+  alignas(cache_line_size) std::atomic<Node *> m_head;
+  alignas(cache_line_size) Node m_stub;
+  std::array<Pool, SlotCount> m_pools;
+};
+
+} // namespace strobe
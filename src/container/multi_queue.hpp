@@ -0,0 +1,171 @@
+#pragma once
+
+#include "container/kary_heap.hpp"
+#include "container/vector.hpp"
+#include "sync/cache_line.hpp"
+#include "sync/spin_lock.hpp"
+#include "sync/thread_slot.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace strobe {
+
+/// Thread safe relaxed min-priority queue (w.r.t. Compare), a MultiQueue
+/// (Rihani, Sanders, Dementiev).
+/// The elements are distributed over c * P sequential KAryHeaps, each
+/// guarded by a SpinLock. push inserts into a random queue, try_pop samples
+/// two random queues and removes the smaller of the two tops. push and the
+/// sampling in try_pop only take locks with try_lock, a thread which fails
+/// to get a lock samples again instead of waiting. Only if sampling finds
+/// nothing but empty queues, try_pop locks every queue in turn (blocking)
+/// to make sure that all of them are empty.
+///
+/// try_pop does not necessarily return the smallest element, but the
+/// expected rank of the returned element is O(c * P).
+/// NOTE: size() and empty() are only exact, if no other thread modifies the
+/// queue concurrently.
+template <typename T, typename Compare = std::less<T>, std::size_t K = 4>
+class MultiQueue {
+  using Heap = KAryHeap<T, K, strobe::Vector<T>, Compare>;
+
+  struct alignas(cache_line_size) Queue {
+    SpinLock lock;
+    // Written under the lock, read without it to skip empty queues.
+    std::atomic<std::size_t> size{0};
+    Heap heap;
+  };
+
+public:
+  using comparator = Compare;
+  using value_type = T;
+  using size_type = std::size_t;
+
+  /// Creates c * threads internal queues. Larger c reduces contention, but
+  /// increases the rank error of try_pop.
+  explicit MultiQueue(std::size_t threads = std::thread::hardware_concurrency(),
+                      std::size_t c = 2)
+      : m_queueCount(std::max<std::size_t>(1, c * threads)),
+        m_queues(std::make_unique<Queue[]>(m_queueCount)), m_comparator() {}
+
+  MultiQueue(const MultiQueue &) = delete;
+  MultiQueue &operator=(const MultiQueue &) = delete;
+  MultiQueue(MultiQueue &&) = delete;
+  MultiQueue &operator=(MultiQueue &&) = delete;
+
+  void push(const value_type &v) { emplace(v); }
+  void push(value_type &&v) { emplace(std::move(v)); }
+
+  template <typename... Args> void emplace(Args &&...args) {
+    while (true) {
+      Queue &queue = m_queues[random_index()];
+      if (!queue.lock.try_lock()) {
+        continue;
+      }
+      queue.heap.emplace(std::forward<Args>(args)...);
+      queue.size.store(queue.heap.size(), std::memory_order_relaxed);
+      queue.lock.unlock();
+      return;
+    }
+  }
+
+  /// Removes the smaller top of two randomly sampled queues. Returns
+  /// std::nullopt only if all queues were observed to be empty.
+  std::optional<value_type> try_pop() {
+    std::size_t emptySamples = 0;
+    while (emptySamples < m_queueCount) {
+      Queue *a = &m_queues[random_index()];
+      Queue *b = &m_queues[random_index()];
+      if (a->size.load(std::memory_order_relaxed) == 0) {
+        std::swap(a, b);
+      }
+      if (a->size.load(std::memory_order_relaxed) == 0) {
+        ++emptySamples;
+        continue;
+      }
+      if (b->size.load(std::memory_order_relaxed) == 0) {
+        b = a;
+      }
+      if (!a->lock.try_lock()) {
+        continue;
+      }
+      if (b != a && !b->lock.try_lock()) {
+        a->lock.unlock();
+        continue;
+      }
+      Queue *best = a;
+      if (b != a) {
+        if (b->heap.empty() ||
+            (!a->heap.empty() &&
+             m_comparator(a->heap.top(), b->heap.top()))) {
+          b->lock.unlock();
+        } else {
+          a->lock.unlock();
+          best = b;
+        }
+      }
+      if (best->heap.empty()) {
+        best->lock.unlock();
+        continue;
+      }
+      std::optional<value_type> top = pop_locked(*best);
+      best->lock.unlock();
+      return top;
+    }
+    // Sampling only found empty queues, make sure that all of them are.
+    // NOTE: Blocks on the locks, a try_lock could skip a non-empty queue.
+    const std::size_t first = random_index();
+    for (std::size_t i = 0; i < m_queueCount; ++i) {
+      Queue &queue = m_queues[(first + i) % m_queueCount];
+      std::lock_guard lock{queue.lock};
+      if (!queue.heap.empty()) {
+        return pop_locked(queue);
+      }
+    }
+    return std::nullopt;
+  }
+
+  size_type size() const {
+    size_type size = 0;
+    for (std::size_t i = 0; i < m_queueCount; ++i) {
+      size += m_queues[i].size.load(std::memory_order_relaxed);
+    }
+    return size;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  std::size_t queue_count() const { return m_queueCount; }
+
+private:
+  std::optional<value_type> pop_locked(Queue &queue) {
+    std::optional<value_type> top{std::in_place, queue.heap.pop_top()};
+    queue.size.store(queue.heap.size(), std::memory_order_relaxed);
+    return top;
+  }
+
+  // Uniform in [0, m_queueCount), from a xorshift64* generator per thread.
+  std::size_t random_index() const {
+    thread_local std::uint64_t state =
+        (this_thread_slot() + 1) * 0x9E3779B97F4A7C15ull;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    const std::uint64_t r = (state * 0x2545F4914F6CDD1Dull) >> 32;
+    return static_cast<std::size_t>((r * m_queueCount) >> 32);
+  }
+
+  std::size_t m_queueCount;
+  std::unique_ptr<Queue[]> m_queues;
+  [[no_unique_address]] comparator m_comparator;
+};
+
+} // namespace strobe
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/FreelistPool.hpp"
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace strobe {
+
+namespace detail {
+
+template <typename T> struct PairingNode {
+  T data;
+  struct PairingNode *child;
+  struct PairingNode *next;
+  // Left sibling, or the parent if this is the first child.
+  struct PairingNode *prev;
+
+  template <typename... Args>
+  explicit PairingNode(Args &&...args)
+      : data(std::forward<Args>(args)...), child(nullptr), next(nullptr),
+        prev(nullptr) {}
+};
+
+} // namespace detail
+
+/// Addressable min-heap (w.r.t. Compare) as a single heap-ordered tree in
+/// child-sibling representation. push, meld and decrease_key link two trees
+/// in O(1), pop combines the children of the root with the two-pass pairing.
+/// Nodes are allocated from A, by default a freelist pool owned by the heap.
+template <typename T, typename Compare = std::less<T>,
+          Allocator A = FreelistResource<sizeof(detail::PairingNode<T>),
+                                         alignof(detail::PairingNode<T>)>>
+class PairingHeap {
+private:
+  using Node = detail::PairingNode<T>;
+
+public:
+  using comparator = Compare;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  using handle = void *;
+
+  PairingHeap() : m_root(nullptr), m_allocator(), m_comparator() {}
+  explicit PairingHeap(A allocator, const Compare &compare = {})
+      : m_root(nullptr), m_allocator(std::move(allocator)),
+        m_comparator(compare) {}
+
+  ~PairingHeap() { clear(); }
+
+  PairingHeap(const PairingHeap &) = delete;
+  PairingHeap &operator=(const PairingHeap &) = delete;
+
+  PairingHeap(PairingHeap &&o)
+      : m_root(std::exchange(o.m_root, nullptr)),
+        m_allocator(std::move(o.m_allocator)),
+        m_comparator(std::move(o.m_comparator)) {}
+
+  PairingHeap &operator=(PairingHeap &&o) {
+    if (this == &o) {
+      return *this;
+    }
+    clear();
+    m_root = std::exchange(o.m_root, nullptr);
+    m_allocator = std::move(o.m_allocator);
+    m_comparator = std::move(o.m_comparator);
+    return *this;
+  }
+
+  template <typename... Args>
+    requires(std::constructible_from<T, Args...>)
+  handle emplace(Args &&...args) {
+    Node *node = emplace_node<Args...>(std::forward<Args>(args)...);
+    m_root = m_root == nullptr ? node : link(m_root, node);
+    return reinterpret_cast<void *>(node);
+  }
+  handle push(const value_type &v) { return emplace<const value_type &>(v); }
+  handle push(value_type &&v) { return emplace<value_type &&>(std::move(v)); }
+
+  bool empty() const { return m_root == nullptr; }
+
+  const_reference top() const {
+    assert(!empty());
+    return m_root->data;
+  }
+
+  void pop() {
+    assert(!empty());
+    Node *node = m_root;
+    m_root = combine(node->child);
+    destroy_node(node);
+  }
+
+  void decrease_key(handle h, const value_type &new_value) {
+    decrease_key(h, [&](value_type &value) { value = new_value; });
+  }
+
+  void decrease_key(handle h, value_type &&new_value) {
+    decrease_key(h, [&](value_type &value) { value = std::move(new_value); });
+  }
+
+  template <typename Func>
+    requires std::is_invocable_v<Func, value_type &>
+  void decrease_key(handle h, Func func) {
+    assert(h != nullptr);
+    Node *node = reinterpret_cast<Node *>(h);
+    func(node->data);
+    if (node != m_root) {
+      detach(node);
+      m_root = link(m_root, node);
+    }
+  }
+
+  void erase(handle h) {
+    assert(h != nullptr);
+    Node *node = reinterpret_cast<Node *>(h);
+    if (node == m_root) {
+      pop();
+      return;
+    }
+    detach(node);
+    Node *subtree = combine(node->child);
+    destroy_node(node);
+    if (subtree != nullptr) {
+      m_root = link(m_root, subtree);
+    }
+  }
+
+  /// Moves all elements of o into this heap, handles of o stay valid. The
+  /// pool of o is absorbed in O(log n) (linear in its slab count), linking
+  /// the roots is O(1). Other allocators must always compare equal.
+  void meld(PairingHeap &&o) {
+    if (this == &o || o.m_root == nullptr) {
+      return;
+    }
+    if constexpr (requires { m_allocator.absorb(std::move(o.m_allocator)); }) {
+      m_allocator.absorb(std::move(o.m_allocator));
+    } else {
+      static_assert(AllocatorTraits<A>::is_always_equal);
+    }
+    Node *root = std::exchange(o.m_root, nullptr);
+    m_root = m_root == nullptr ? root : link(m_root, root);
+  }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T> ||
+                  !requires(A a) { a.release(); }) {
+      // The child-sibling tree is a binary tree (child = left, next = right),
+      // which is destroyed without recursion by rotating left children up.
+      Node *node = m_root;
+      while (node != nullptr) {
+        if (Node *child = node->child; child != nullptr) {
+          node->child = child->next;
+          child->next = node;
+          node = child;
+        } else {
+          Node *next = node->next;
+          destroy_node(node);
+          node = next;
+        }
+      }
+    }
+    if constexpr (requires(A a) { a.release(); }) {
+      m_allocator.release();
+    }
+    m_root = nullptr;
+  }
+
+private:
+  // Links two roots, the loser becomes the first child of the winner.
+  Node *link(Node *a, Node *b) {
+    assert(a->next == nullptr && a->prev == nullptr);
+    assert(b->next == nullptr && b->prev == nullptr);
+    if (m_comparator(b->data, a->data)) {
+      std::swap(a, b);
+    }
+    b->next = a->child;
+    if (b->next != nullptr) {
+      b->next->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+    return a;
+  }
+
+  // Removes the subtree of node from its parent.
+  void detach(Node *node) {
+    assert(node->prev != nullptr);
+    if (node->prev->child == node) {
+      node->prev->child = node->next;
+    } else {
+      node->prev->next = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    }
+    node->next = nullptr;
+    node->prev = nullptr;
+  }
+
+  // Two-pass pairing: links the siblings pairwise from left to right, then
+  // links the results from right to left into a single tree.
+  Node *combine(Node *first) {
+    if (first == nullptr) {
+      return nullptr;
+    }
+    // Results of the first pass are stacked through next.
+    Node *stack = nullptr;
+    while (first != nullptr) {
+      Node *a = first;
+      Node *b = a->next;
+      a->prev = nullptr;
+      a->next = nullptr;
+      if (b == nullptr) {
+        a->next = stack;
+        stack = a;
+        break;
+      }
+      first = b->next;
+      b->prev = nullptr;
+      b->next = nullptr;
+      Node *winner = link(a, b);
+      winner->next = stack;
+      stack = winner;
+    }
+    Node *root = stack;
+    stack = std::exchange(root->next, nullptr);
+    while (stack != nullptr) {
+      Node *next = std::exchange(stack->next, nullptr);
+      root = link(root, stack);
+      stack = next;
+    }
+    return root;
+  }
+
+  template <typename... Args>
+    requires std::constructible_from<T, Args...>
+  Node *emplace_node(Args &&...args) {
+    Node *node = alloc_node();
+    std::construct_at(node, std::forward<Args>(args)...);
+    return node;
+  }
+
+  Node *alloc_node() {
+    Node *node = static_cast<Node *>(
+        AllocatorTraits<A>::allocate(m_allocator, sizeof(Node), alignof(Node)));
+    assert(node != nullptr);
+    return node;
+  }
+
+  void destroy_node(Node *node) {
+    std::destroy_at(node);
+    free_node(node);
+  }
+
+  void free_node(Node *node) {
+    AllocatorTraits<A>::deallocate(m_allocator, node, sizeof(Node),
+                                   alignof(Node));
+  }
+
+  Node *m_root;
+  [[no_unique_address]] A m_allocator;
+  [[no_unique_address]] comparator m_comparator;
+};
+
+} // namespace strobe
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "container/vector.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace strobe {
+
+/// Maps a key to a unsigned integer with the same order.
+template <typename K> struct radix_key;
+
+template <std::unsigned_integral K> struct radix_key<K> {
+  using type = K;
+  static constexpr type encode(K k) { return k; }
+};
+
+template <std::signed_integral K> struct radix_key<K> {
+  using type = std::make_unsigned_t<K>;
+  static constexpr type encode(K k) {
+    return static_cast<type>(k) ^
+           (type(1) << (std::numeric_limits<type>::digits - 1));
+  }
+};
+
+// Positive floats are ordered like their bit pattern, negative floats in
+// reverse order.
+template <std::floating_point K>
+  requires(sizeof(K) == 4 || sizeof(K) == 8)
+struct radix_key<K> {
+  using type =
+      std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+  static constexpr type encode(K k) {
+    constexpr type SignBit = type(1)
+                             << (std::numeric_limits<type>::digits - 1);
+    const type bits = std::bit_cast<type>(k);
+    return (bits & SignBit) ? ~bits : bits | SignBit;
+  }
+};
+
+/// Monotone radix heap. A element is stored in the bucket
+/// bit_width(key ^ last), where last is the key of the last popped minimum.
+/// Once bucket 0 runs empty, the first non-empty bucket is scanned for its
+/// minimum and redistributed into the lower buckets. Every element moves at
+/// most once per bucket, i.e. operations are amortized O(log C).
+///
+/// NOTE: The heap is monotone, pushed keys must not be smaller than the key of
+/// the last popped element. Once the heap runs empty any key can be pushed.
+template <typename T, typename Key = std::identity>
+  requires(std::is_invocable_v<const Key &, const T &>)
+class RadixHeap {
+  using K = std::remove_cvref_t<std::invoke_result_t<const Key &, const T &>>;
+  using RK = radix_key<K>;
+  using U = typename RK::type;
+  using Bucket = strobe::Vector<T>;
+  static constexpr std::size_t BucketCount =
+      std::numeric_limits<U>::digits + 1;
+
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  RadixHeap(const Key &key = {}) : m_last(0), m_size(0), m_key(key) {}
+
+  // NOTE: Does not redistribute, last must only advance in pop(), otherwise
+  // keys between the last popped key and the current minimum could no
+  // longer be pushed. If bucket 0 is empty the minimum is searched in the
+  // first non-empty bucket, which pop() then scans again.
+  const_reference top() const {
+    assert(!empty());
+    if (!m_buckets[0].empty()) {
+      return m_buckets[0].back();
+    }
+    const Bucket &bucket = m_buckets[firstNonEmpty()];
+    const T *min = &bucket[0];
+    U minKey = encode(*min);
+    for (const T &value : bucket) {
+      const U k = encode(value);
+      if (k < minKey) {
+        min = &value;
+        minKey = k;
+      }
+    }
+    return *min;
+  }
+
+  bool empty() const { return m_size == 0; }
+
+  size_type size() const { return m_size; }
+
+  void push(const value_type &lvalue) { emplace(lvalue); }
+
+  void push(value_type &&rvalue) { emplace(std::move(rvalue)); }
+
+  template <typename... Args> void emplace(Args &&...args) {
+    T value(std::forward<Args>(args)...);
+    const U k = encode(value);
+    assert(k >= m_last);
+    m_buckets[bucketOf(k)].push_back(std::move(value));
+    ++m_size;
+  }
+
+  void pop() {
+    assert(!empty());
+    if (m_buckets[0].empty()) {
+      redistribute();
+    }
+    m_buckets[0].pop_back();
+    if (--m_size == 0) {
+      m_last = 0;
+    }
+  }
+
+private:
+  U encode(const T &value) const { return RK::encode(m_key(value)); }
+
+  size_type bucketOf(U k) const {
+    return static_cast<size_type>(std::bit_width(static_cast<U>(k ^ m_last)));
+  }
+
+  // Index of the first non-empty bucket above bucket 0.
+  size_type firstNonEmpty() const {
+    size_type i = 1;
+    while (m_buckets[i].empty()) {
+      ++i;
+      assert(i < BucketCount);
+    }
+    return i;
+  }
+
+  // Moves the elements of the first non-empty bucket into the lower buckets,
+  // relative to its minimum.
+  void redistribute() {
+    Bucket &bucket = m_buckets[firstNonEmpty()];
+    U min = std::numeric_limits<U>::max();
+    for (const T &value : std::as_const(bucket)) {
+      min = std::min(min, encode(value));
+    }
+    m_last = min;
+    for (T &value : bucket) {
+      // Elements of bucket i only differ from the new minimum in the lower
+      // i - 1 bits, so they always end up in a lower bucket.
+      m_buckets[bucketOf(encode(value))].push_back(std::move(value));
+    }
+    bucket.clear();
+  }
+
+  std::array<Bucket, BucketCount> m_buckets;
+  U m_last;
+  size_type m_size;
+  [[no_unique_address]] Key m_key;
+};
+
+template <typename T, typename Key>
+struct is_trivially_relocatable<RadixHeap<T, Key>>
+    : std::bool_constant<is_trivially_relocatable_v<Vector<T>> &&
+                         is_trivially_relocatable_v<Key>> {};
+
+} // namespace strobe
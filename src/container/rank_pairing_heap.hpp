@@ -0,0 +1,334 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/FreelistPool.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace strobe {
+
+namespace detail {
+
+template <typename T> struct RankPairingNode {
+  T data;
+  struct RankPairingNode *left;
+  // Right child, for roots the next root in the circular root list.
+  struct RankPairingNode *right;
+  struct RankPairingNode *parent;
+  int rank;
+
+  template <typename... Args>
+  explicit RankPairingNode(Args &&...args)
+      : data(std::forward<Args>(args)...), left(nullptr), right(nullptr),
+        parent(nullptr), rank(0) {}
+};
+
+} // namespace detail
+
+/// Addressable min-heap (w.r.t. Compare), type-1 rank-pairing heap with
+/// one-pass linking (Haeupler, Sen, Tarjan). The heap is a circular list of
+/// half-ordered half trees, a root only has a left child. push, meld and
+/// decrease_key are O(1), pop is amortized O(log n).
+/// Nodes are allocated from A, by default a freelist pool owned by the heap.
+template <typename T, typename Compare = std::less<T>,
+          Allocator A = FreelistResource<sizeof(detail::RankPairingNode<T>),
+                                         alignof(detail::RankPairingNode<T>)>>
+class RankPairingHeap {
+private:
+  using Node = detail::RankPairingNode<T>;
+  // Ranks of type-1 rank-pairing heaps are bounded by log_phi(n) < 1.45 * 64.
+  static constexpr std::size_t MAX_RANK = 96;
+
+public:
+  using comparator = Compare;
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  using handle = void *;
+
+  RankPairingHeap() : m_min(nullptr), m_allocator(), m_comparator() {}
+  explicit RankPairingHeap(A allocator, const Compare &compare = {})
+      : m_min(nullptr), m_allocator(std::move(allocator)),
+        m_comparator(compare) {}
+
+  ~RankPairingHeap() { clear(); }
+
+  RankPairingHeap(const RankPairingHeap &) = delete;
+  RankPairingHeap &operator=(const RankPairingHeap &) = delete;
+
+  RankPairingHeap(RankPairingHeap &&o)
+      : m_min(std::exchange(o.m_min, nullptr)),
+        m_allocator(std::move(o.m_allocator)),
+        m_comparator(std::move(o.m_comparator)) {}
+
+  RankPairingHeap &operator=(RankPairingHeap &&o) {
+    if (this == &o) {
+      return *this;
+    }
+    clear();
+    m_min = std::exchange(o.m_min, nullptr);
+    m_allocator = std::move(o.m_allocator);
+    m_comparator = std::move(o.m_comparator);
+    return *this;
+  }
+
+  template <typename... Args>
+    requires(std::constructible_from<T, Args...>)
+  handle emplace(Args &&...args) {
+    Node *node = emplace_node<Args...>(std::forward<Args>(args)...);
+    push_root(node);
+    return reinterpret_cast<void *>(node);
+  }
+  handle push(const value_type &v) { return emplace<const value_type &>(v); }
+  handle push(value_type &&v) { return emplace<value_type &&>(std::move(v)); }
+
+  bool empty() const { return m_min == nullptr; }
+
+  const_reference top() const {
+    assert(!empty());
+    return m_min->data;
+  }
+
+  void pop() {
+    assert(!empty());
+    Node *min = m_min;
+    std::array<Node *, MAX_RANK> byRank{};
+    int maxRank = -1;
+    Node *roots = nullptr; // singly linked through right.
+
+    // One-pass linking: two half trees of equal rank are linked once, the
+    // result is not linked again.
+    auto add = [&](Node *node) {
+      node->parent = nullptr;
+      const int r = node->rank;
+      assert(r >= 0 && static_cast<std::size_t>(r) < MAX_RANK);
+      if (Node *other = std::exchange(byRank[r], nullptr); other != nullptr) {
+        Node *winner = link(other, node);
+        winner->right = roots;
+        roots = winner;
+      } else {
+        byRank[r] = node;
+        maxRank = std::max(maxRank, r);
+      }
+    };
+    for (Node *node = min->right; node != min;) {
+      Node *next = node->right;
+      add(node);
+      node = next;
+    }
+    // The right spine of the left subtree of min becomes new half trees.
+    for (Node *node = min->left; node != nullptr;) {
+      Node *next = node->right;
+      node->right = nullptr;
+      node->rank = rank_of(node->left) + 1;
+      add(node);
+      node = next;
+    }
+    for (int r = 0; r <= maxRank; ++r) {
+      if (byRank[r] != nullptr) {
+        byRank[r]->right = roots;
+        roots = byRank[r];
+      }
+    }
+    destroy_node(min);
+
+    m_min = nullptr;
+    while (roots != nullptr) {
+      Node *next = roots->right;
+      push_root(roots);
+      roots = next;
+    }
+  }
+
+  void decrease_key(handle h, const value_type &new_value) {
+    decrease_key(h, [&](value_type &value) { value = new_value; });
+  }
+
+  void decrease_key(handle h, value_type &&new_value) {
+    decrease_key(h, [&](value_type &value) { value = std::move(new_value); });
+  }
+
+  template <typename Func>
+    requires std::is_invocable_v<Func, value_type &>
+  void decrease_key(handle h, Func func) {
+    assert(h != nullptr);
+    Node *node = reinterpret_cast<Node *>(h);
+    func(node->data);
+    if (node->parent == nullptr) {
+      if (m_comparator(node->data, m_min->data)) {
+        m_min = node;
+      }
+    } else {
+      cut(node);
+    }
+  }
+
+  void erase(handle h) {
+    assert(h != nullptr);
+    Node *node = reinterpret_cast<Node *>(h);
+    // Same as decreasing the key to -inf and popping it.
+    if (node->parent != nullptr) {
+      cut(node);
+    }
+    m_min = node;
+    pop();
+  }
+
+  /// Moves all elements of o into this heap, handles of o stay valid. The
+  /// pool of o is absorbed in O(log n) (linear in its slab count), linking
+  /// the roots is O(1). Other allocators must always compare equal.
+  void meld(RankPairingHeap &&o) {
+    if (this == &o || o.m_min == nullptr) {
+      return;
+    }
+    if constexpr (requires { m_allocator.absorb(std::move(o.m_allocator)); }) {
+      m_allocator.absorb(std::move(o.m_allocator));
+    } else {
+      static_assert(AllocatorTraits<A>::is_always_equal);
+    }
+    Node *min = std::exchange(o.m_min, nullptr);
+    if (m_min == nullptr) {
+      m_min = min;
+      return;
+    }
+    // Splices the two circular root lists.
+    std::swap(m_min->right, min->right);
+    if (m_comparator(min->data, m_min->data)) {
+      m_min = min;
+    }
+  }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T> ||
+                  !requires(A a) { a.release(); }) {
+      if (m_min != nullptr) {
+        // Breaking up the root list turns the forest into a single binary
+        // tree, which is destroyed without recursion by rotating left
+        // children up.
+        Node *node = std::exchange(m_min->right, nullptr);
+        while (node != nullptr) {
+          if (Node *left = node->left; left != nullptr) {
+            node->left = left->right;
+            left->right = node;
+            node = left;
+          } else {
+            Node *next = node->right;
+            destroy_node(node);
+            node = next;
+          }
+        }
+      }
+    }
+    if constexpr (requires(A a) { a.release(); }) {
+      m_allocator.release();
+    }
+    m_min = nullptr;
+  }
+
+private:
+  static int rank_of(const Node *node) {
+    return node == nullptr ? -1 : node->rank;
+  }
+
+  void push_root(Node *node) {
+    node->parent = nullptr;
+    if (m_min == nullptr) {
+      node->right = node;
+      m_min = node;
+    } else {
+      node->right = m_min->right;
+      m_min->right = node;
+      if (m_comparator(node->data, m_min->data)) {
+        m_min = node;
+      }
+    }
+  }
+
+  // Links two half trees of equal rank, the loser becomes the left child of
+  // the winner and the old left subtree of the winner its right subtree.
+  Node *link(Node *a, Node *b) {
+    if (m_comparator(b->data, a->data)) {
+      std::swap(a, b);
+    }
+    b->right = a->left;
+    if (b->right != nullptr) {
+      b->right->parent = b;
+    }
+    a->left = b;
+    b->parent = a;
+    a->rank = b->rank + 1;
+    return a;
+  }
+
+  // Moves node with its left subtree into the root list, its right subtree
+  // takes its place. Restores the type-1 rank rule on the path upwards.
+  void cut(Node *node) {
+    Node *parent = node->parent;
+    assert(parent != nullptr);
+    Node *right = node->right;
+    if (parent->left == node) {
+      parent->left = right;
+    } else {
+      parent->right = right;
+    }
+    if (right != nullptr) {
+      right->parent = parent;
+    }
+    node->rank = rank_of(node->left) + 1;
+    push_root(node);
+
+    Node *u = parent;
+    while (u->parent != nullptr) {
+      const int r1 = rank_of(u->left);
+      const int r2 = rank_of(u->right);
+      const int k = r1 == r2 ? r1 + 1 : std::max(r1, r2);
+      if (k >= u->rank) {
+        return;
+      }
+      u->rank = k;
+      u = u->parent;
+    }
+    u->rank = rank_of(u->left) + 1;
+  }
+
+  template <typename... Args>
+    requires std::constructible_from<T, Args...>
+  Node *emplace_node(Args &&...args) {
+    Node *node = alloc_node();
+    std::construct_at(node, std::forward<Args>(args)...);
+    return node;
+  }
+
+  Node *alloc_node() {
+    Node *node = static_cast<Node *>(
+        AllocatorTraits<A>::allocate(m_allocator, sizeof(Node), alignof(Node)));
+    assert(node != nullptr);
+    return node;
+  }
+
+  void destroy_node(Node *node) {
+    std::destroy_at(node);
+    free_node(node);
+  }
+
+  void free_node(Node *node) {
+    AllocatorTraits<A>::deallocate(m_allocator, node, sizeof(Node),
+                                   alignof(Node));
+  }
+
+  Node *m_min;
+  [[no_unique_address]] A m_allocator;
+  [[no_unique_address]] comparator m_comparator;
+};
+
+} // namespace strobe
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+    (defined(__GNUC__) || defined(__clang__))
+#define STROBE_SELECT_CHILD_X86 1
+#include <immintrin.h>
+#else
+#define STROBE_SELECT_CHILD_X86 0
+#endif
+
+namespace strobe {
+
+/// Returns the index of the first element of children[0..K), which is not
+/// ordered after any other element, i.e. the child a heap would sift up.
+template <typename T, std::size_t K, typename Compare>
+std::size_t select_child_scalar(const T *children, const Compare &compare) {
+  std::size_t next = 0;
+  for (std::size_t n = 1; n < K; ++n) {
+    if (compare(children[n], children[next])) {
+      next = n;
+    }
+  }
+  return next;
+}
+
+/// Is true iff. select_child has a vectorized implementation for T, K and
+/// Compare, which is the case for 32-bit arithmetic types ordered by
+/// std::less or std::greater, with K a multiple of 8.
+/// NOTE: For floats the result is unspecified if a child is NaN.
+template <typename T, std::size_t K, typename Compare>
+inline constexpr bool simd_select_child_v =
+    STROBE_SELECT_CHILD_X86 && K % 8 == 0 &&
+    (std::same_as<T, std::int32_t> || std::same_as<T, std::uint32_t> ||
+     std::same_as<T, float>) &&
+    (std::same_as<Compare, std::less<T>> ||
+     std::same_as<Compare, std::greater<T>>);
+
+#if STROBE_SELECT_CHILD_X86
+namespace detail {
+
+template <typename T> struct simd_select_ops;
+
+template <> struct simd_select_ops<std::int32_t> {
+  __attribute__((target("avx2"))) static __m256i load8(const std::int32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  __attribute__((target("avx2"))) static __m256i min8(__m256i a, __m256i b) {
+    return _mm256_min_epi32(a, b);
+  }
+  __attribute__((target("avx2"))) static __m256i max8(__m256i a, __m256i b) {
+    return _mm256_max_epi32(a, b);
+  }
+  __attribute__((target("avx2"))) static unsigned eq8(__m256i a, __m256i b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+
+  __attribute__((target("avx512f"))) static __m512i
+  load16(const std::int32_t *p) {
+    return _mm512_loadu_si512(p);
+  }
+  __attribute__((target("avx512f"))) static std::int32_t
+  reduceMin16(__m512i v) {
+    return _mm512_reduce_min_epi32(v);
+  }
+  __attribute__((target("avx512f"))) static std::int32_t
+  reduceMax16(__m512i v) {
+    return _mm512_reduce_max_epi32(v);
+  }
+  __attribute__((target("avx512f"))) static unsigned eq16(__m512i v,
+                                                          std::int32_t x) {
+    return _mm512_cmpeq_epi32_mask(v, _mm512_set1_epi32(x));
+  }
+};
+
+template <> struct simd_select_ops<std::uint32_t> {
+  __attribute__((target("avx2"))) static __m256i
+  load8(const std::uint32_t *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  __attribute__((target("avx2"))) static __m256i min8(__m256i a, __m256i b) {
+    return _mm256_min_epu32(a, b);
+  }
+  __attribute__((target("avx2"))) static __m256i max8(__m256i a, __m256i b) {
+    return _mm256_max_epu32(a, b);
+  }
+  __attribute__((target("avx2"))) static unsigned eq8(__m256i a, __m256i b) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+  }
+
+  __attribute__((target("avx512f"))) static __m512i
+  load16(const std::uint32_t *p) {
+    return _mm512_loadu_si512(p);
+  }
+  __attribute__((target("avx512f"))) static std::uint32_t
+  reduceMin16(__m512i v) {
+    return _mm512_reduce_min_epu32(v);
+  }
+  __attribute__((target("avx512f"))) static std::uint32_t
+  reduceMax16(__m512i v) {
+    return _mm512_reduce_max_epu32(v);
+  }
+  __attribute__((target("avx512f"))) static unsigned eq16(__m512i v,
+                                                          std::uint32_t x) {
+    return _mm512_cmpeq_epi32_mask(v, _mm512_set1_epi32(x));
+  }
+};
+
+template <> struct simd_select_ops<float> {
+  __attribute__((target("avx2"))) static __m256i load8(const float *p) {
+    return _mm256_castps_si256(_mm256_loadu_ps(p));
+  }
+  __attribute__((target("avx2"))) static __m256i min8(__m256i a, __m256i b) {
+    return _mm256_castps_si256(
+        _mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+  }
+  __attribute__((target("avx2"))) static __m256i max8(__m256i a, __m256i b) {
+    return _mm256_castps_si256(
+        _mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+  }
+  __attribute__((target("avx2"))) static unsigned eq8(__m256i a, __m256i b) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(
+        _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+  }
+
+  __attribute__((target("avx512f"))) static __m512 load16(const float *p) {
+    return _mm512_loadu_ps(p);
+  }
+  __attribute__((target("avx512f"))) static float reduceMin16(__m512 v) {
+    return _mm512_reduce_min_ps(v);
+  }
+  __attribute__((target("avx512f"))) static float reduceMax16(__m512 v) {
+    return _mm512_reduce_max_ps(v);
+  }
+  __attribute__((target("avx512f"))) static unsigned eq16(__m512 v, float x) {
+    return _mm512_cmp_ps_mask(v, _mm512_set1_ps(x), _CMP_EQ_OQ);
+  }
+};
+
+// Broadcasts the minimum (maximum) of the 8 lanes into all lanes. The
+// permutations only move bits, therefore they are shared by all types.
+template <typename Ops, bool Max>
+__attribute__((target("avx2"))) inline __m256i reduce8(__m256i v) {
+  const __m256i a = _mm256_permute2x128_si256(v, v, 1);
+  v = Max ? Ops::max8(v, a) : Ops::min8(v, a);
+  const __m256i b = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+  v = Max ? Ops::max8(v, b) : Ops::min8(v, b);
+  const __m256i c = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+  v = Max ? Ops::max8(v, c) : Ops::min8(v, c);
+  return v;
+}
+
+template <typename T, std::size_t K, bool Max>
+__attribute__((target("avx2"))) std::size_t
+select_child_avx2(const T *children) {
+  using Ops = simd_select_ops<T>;
+  __m256i best = Ops::load8(children);
+  for (std::size_t i = 8; i < K; i += 8) {
+    const __m256i v = Ops::load8(children + i);
+    best = Max ? Ops::max8(best, v) : Ops::min8(best, v);
+  }
+  best = reduce8<Ops, Max>(best);
+  for (std::size_t i = 0; i < K; i += 8) {
+    const unsigned mask = Ops::eq8(Ops::load8(children + i), best);
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return 0;
+}
+
+template <typename T, std::size_t K, bool Max>
+__attribute__((target("avx512f"))) std::size_t
+select_child_avx512(const T *children) {
+  static_assert(K % 16 == 0);
+  using Ops = simd_select_ops<T>;
+  T best = Max ? Ops::reduceMax16(Ops::load16(children))
+               : Ops::reduceMin16(Ops::load16(children));
+  for (std::size_t i = 16; i < K; i += 16) {
+    const T b = Max ? Ops::reduceMax16(Ops::load16(children + i))
+                    : Ops::reduceMin16(Ops::load16(children + i));
+    best = Max ? (b > best ? b : best) : (b < best ? b : best);
+  }
+  for (std::size_t i = 0; i < K; i += 16) {
+    const unsigned mask = Ops::eq16(Ops::load16(children + i), best);
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return 0;
+}
+
+// Resolved once, the branches on these are perfectly predictable.
+inline const bool cpu_has_avx2 = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}();
+
+inline const bool cpu_has_avx512f = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f") != 0;
+}();
+
+} // namespace detail
+#endif
+
+/// Same result as select_child_scalar. If simd_select_child_v holds, the
+/// children are compared with AVX-512 (K a multiple of 16) or AVX2. The
+/// instruction set is selected at compile time if the target already
+/// supports it, otherwise at runtime with a scalar fallback.
+template <typename T, std::size_t K, typename Compare>
+inline std::size_t select_child(const T *children, const Compare &compare) {
+#if STROBE_SELECT_CHILD_X86
+  if constexpr (simd_select_child_v<T, K, Compare>) {
+    constexpr bool Max = std::same_as<Compare, std::greater<T>>;
+    if constexpr (K % 16 == 0) {
+#ifdef __AVX512F__
+      return detail::select_child_avx512<T, K, Max>(children);
+#else
+      if (detail::cpu_has_avx512f) {
+        return detail::select_child_avx512<T, K, Max>(children);
+      }
+#endif
+    }
+#ifdef __AVX2__
+    return detail::select_child_avx2<T, K, Max>(children);
+#else
+    if (detail::cpu_has_avx2) {
+      return detail::select_child_avx2<T, K, Max>(children);
+    }
+#endif
+  }
+#endif
+  return select_child_scalar<T, K, Compare>(children, compare);
+}
+
+} // namespace strobe
@@ -0,0 +1,490 @@
+#pragma once
+
+#include "container/container_concepts.hpp"
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+namespace strobe {
+
+/// Vector, which stores up to N elements inline and only allocates from the
+/// allocator if it grows beyond that. Provides the same interface as Vector.
+/// NOTE: Moving a SmallVector, which is stored inline, moves the elements.
+template <typename T, std::size_t N, Allocator A = strobe::Mallocator>
+class SmallVector {
+  using ATraits = AllocatorTraits<A>;
+  static_assert(N > 0, "Use Vector if no elements should be stored inline");
+
+public:
+  using value_type = T;
+  using allocator_type = A;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = ATraits::template pointer<value_type>;
+  using const_pointer = ATraits::template const_pointer<value_type>;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type inline_capacity = N;
+
+  // =================== Constructors =======================
+  explicit SmallVector(const A &alloc = {})
+      : m_buffer(inlineBuffer()), m_size(0), m_capacity(N),
+        m_allocator(alloc) {}
+
+  explicit SmallVector(size_type size, const A &alloc = {})
+    requires std::is_default_constructible_v<T>
+      : SmallVector(alloc) {
+    reserve(size);
+    std::uninitialized_value_construct_n(m_buffer, size);
+    m_size = size;
+  }
+
+  explicit SmallVector(size_type size, const T &value, const A &alloc = {})
+      : SmallVector(alloc) {
+    reserve(size);
+    std::uninitialized_fill_n(m_buffer, size, value);
+    m_size = size;
+  }
+
+  template <std::ranges::range Rg>
+    requires(std::same_as<std::ranges::range_value_t<Rg>, value_type>)
+  explicit SmallVector(const Rg &rg, const A &alloc = {}) : SmallVector(alloc) {
+    if constexpr (std::ranges::forward_range<Rg>) {
+      append(rg);
+    } else {
+      for (const T &v : rg) {
+        push_back(v);
+      }
+    }
+  }
+
+  ~SmallVector() {
+    clear();
+    release();
+  }
+
+  SmallVector(const SmallVector &o)
+      : SmallVector(
+            ATraits::select_on_container_copy_construction(o.m_allocator)) {
+    reserve(o.m_size);
+    uninitialized_copy_n(o.m_buffer, o.m_size, m_buffer);
+    m_size = o.m_size;
+  }
+
+  SmallVector &operator=(const SmallVector &o) {
+    if (this == &o) {
+      return *this;
+    }
+    clear();
+    if (ATraits::propagate_on_container_copy_assignment &&
+        !strobe::alloc_equals(m_allocator, o.m_allocator)) {
+      release();
+      m_allocator = o.m_allocator;
+    }
+    reserve(o.m_size);
+    uninitialized_copy_n(o.m_buffer, o.m_size, m_buffer);
+    m_size = o.m_size;
+    return *this;
+  }
+
+  SmallVector(SmallVector &&o) noexcept
+      : m_buffer(inlineBuffer()), m_size(0), m_capacity(N),
+        m_allocator(std::move(o.m_allocator)) {
+    if (o.isInline()) {
+      relocate_n(o.m_buffer, o.m_size, m_buffer);
+      m_size = std::exchange(o.m_size, 0);
+    } else {
+      m_buffer = std::exchange(o.m_buffer, o.inlineBuffer());
+      m_capacity = std::exchange(o.m_capacity, N);
+      m_size = std::exchange(o.m_size, 0);
+    }
+  }
+
+  SmallVector &operator=(SmallVector &&o) noexcept {
+    if (this == &o) {
+      return *this;
+    }
+    clear();
+    const bool equalAllocator =
+        strobe::alloc_equals(m_allocator, o.m_allocator);
+    if (!o.isInline() &&
+        (ATraits::propagate_on_container_move_assignment || equalAllocator)) {
+      // Safe to take over the buffer directly.
+      release();
+      if (ATraits::propagate_on_container_move_assignment) {
+        m_allocator = std::move(o.m_allocator);
+      }
+      m_buffer = std::exchange(o.m_buffer, o.inlineBuffer());
+      m_capacity = std::exchange(o.m_capacity, N);
+      m_size = std::exchange(o.m_size, 0);
+    } else {
+      // Inline elements (or elements from a incompatible allocator) have to
+      // be relocated one by one.
+      reserve(o.m_size);
+      relocate_n(o.m_buffer, o.m_size, m_buffer);
+      m_size = std::exchange(o.m_size, 0);
+    }
+    return *this;
+  }
+
+  // ===================== Vector-Interface ===================
+
+  T &operator[](size_type i) {
+    assert(i < m_size);
+    return m_buffer[i];
+  }
+
+  const T &operator[](size_type i) const {
+    assert(i < m_size);
+    return m_buffer[i];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (m_size == m_capacity) [[unlikely]] {
+      // NOTE: args might reference a element of this vector, construct the
+      // new element before the old buffer is released.
+      return emplace_back_grow(std::forward<Args>(args)...);
+    }
+    std::construct_at(m_buffer + m_size, std::forward<Args>(args)...);
+    return m_buffer[m_size++];
+  }
+
+  void push_front(const T &value) { insert(begin(), value); }
+
+  void pop_back() {
+    assert(m_size != 0);
+    m_size--;
+    std::destroy_at(m_buffer + m_size);
+  }
+
+  void pop_front() {
+    assert(m_size != 0);
+    std::destroy_at(m_buffer);
+    closeGap(0, 1);
+    --m_size;
+  }
+
+  void clear() {
+    std::destroy_n(m_buffer, m_size);
+    m_size = 0;
+  }
+
+  size_type size() const { return m_size; }
+
+  size_type capacity() const { return m_capacity; }
+
+  bool empty() const { return m_size == 0; }
+
+  /// True iff the elements are stored inline, i.e. no memory is allocated.
+  bool is_inline() const { return isInline(); }
+
+  void reserve(size_type newCapacity) {
+    if (newCapacity > m_capacity) {
+      grow(newCapacity);
+    }
+  }
+
+  void resize(size_type newSize, const T &value) {
+    if (newSize < m_size) {
+      std::destroy(m_buffer + newSize, m_buffer + m_size);
+    } else if (newSize > m_size) {
+      reserve(newSize);
+      std::uninitialized_fill(m_buffer + m_size, m_buffer + newSize, value);
+    }
+    m_size = newSize;
+  }
+
+  void resize(size_type newSize)
+    requires(std::is_default_constructible_v<T>)
+  {
+    if (newSize < m_size) {
+      std::destroy(m_buffer + newSize, m_buffer + m_size);
+    } else if (newSize > m_size) {
+      reserve(newSize);
+      std::uninitialized_value_construct(m_buffer + m_size, m_buffer + newSize);
+    }
+    m_size = newSize;
+  }
+
+  T &back() {
+    assert(m_size != 0);
+    return m_buffer[m_size - 1];
+  }
+  const T &back() const {
+    assert(m_size != 0);
+    return m_buffer[m_size - 1];
+  }
+
+  T &front() {
+    assert(m_size != 0);
+    return m_buffer[0];
+  }
+  const T &front() const {
+    assert(m_size != 0);
+    return m_buffer[0];
+  }
+
+  // ==================== Special Algorithms ========================
+  iterator insert(const_iterator pos, const T &value) {
+    const size_type index = pos - cbegin();
+    if (m_size == m_capacity) {
+      // NOTE: Growing and shifting are combined, value might reference a
+      // element of the old buffer.
+      T *old = m_buffer;
+      auto [buffer, capacity] =
+          ATraits::template allocate_at_least<T>(m_allocator, m_capacity * 2);
+      assert(buffer != nullptr);
+      std::construct_at(buffer + index, value);
+      relocate_n(old, index, buffer);
+      relocate_n(old + index, m_size - index, buffer + index + 1);
+      release();
+      m_buffer = buffer;
+      m_capacity = capacity;
+    } else {
+      const T *src = std::addressof(value);
+      openGap(index, 1);
+      // The referenced element might have been shifted by the gap.
+      if (src >= m_buffer + index && src < m_buffer + m_size) {
+        ++src;
+      }
+      std::construct_at(m_buffer + index, *src);
+    }
+    ++m_size;
+    return begin() + index;
+  }
+
+  iterator insert(std::size_t i, const T &value) {
+    return insert(begin() + i, value);
+  }
+
+  // ========================= Range insertion ==================
+  template <std::ranges::range R> void append(const R &range) {
+    const size_type n = rangeSize(range);
+    reserve(m_size + n);
+    uninitialized_copy_n(std::ranges::begin(range), n, m_buffer + m_size);
+    m_size += n;
+  }
+
+  template <std::ranges::range R>
+  iterator insert(const_iterator pos, const R &range) {
+    const size_type index = pos - cbegin();
+    const size_type n = rangeSize(range);
+    if (n == 0) {
+      return begin() + index;
+    }
+    if (m_size + n > m_capacity) {
+      T *old = m_buffer;
+      auto [buffer, capacity] = ATraits::template allocate_at_least<T>(
+          m_allocator, std::max(m_capacity * 2, m_size + n));
+      assert(buffer != nullptr);
+      uninitialized_copy_n(std::ranges::begin(range), n, buffer + index);
+      relocate_n(old, index, buffer);
+      relocate_n(old + index, m_size - index, buffer + index + n);
+      release();
+      m_buffer = buffer;
+      m_capacity = capacity;
+    } else {
+      openGap(index, n);
+      uninitialized_copy_n(std::ranges::begin(range), n, m_buffer + index);
+    }
+    m_size += n;
+    return begin() + index;
+  }
+
+  // ================= Stack Interface ==============
+  inline void push(const T &value) { push_back(value); }
+  inline T &top() { return back(); }
+  inline const T &top() const { return back(); }
+  inline void pop() { pop_back(); }
+
+  // ================= Set Interface ================
+  inline bool contains(const T &value) const {
+    const auto e = cend();
+    return std::find(cbegin(), e, value) != e;
+  }
+  inline bool add(const T &value) {
+    if (contains(value)) {
+      return false;
+    } else {
+      push_back(value);
+      return true;
+    }
+  }
+  // NOTE: The order of elements is undefined after removing an element.
+  inline bool remove(const T &value) {
+    const auto e = end();
+    auto it = std::find(begin(), e, value);
+    if (it == e) {
+      return false;
+    }
+    if (it != e - 1) {
+      *it = std::move(back());
+    }
+    pop_back();
+    return true;
+  }
+
+  // ================= FIFO-Queue Interface ================
+  void enqueue(const T &value) { push_back(value); }
+
+  const T &peek() const { return front(); }
+
+  T dequeue() {
+    T value = std::move(front());
+    pop_front();
+    return value;
+  }
+
+  // ================= Range Interface ===============
+  inline iterator begin() { return m_buffer; }
+  inline const_iterator begin() const { return m_buffer; }
+  inline iterator end() { return m_buffer + m_size; }
+  inline const_iterator end() const { return m_buffer + m_size; }
+  inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+  inline reverse_iterator rend() { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  inline const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  inline const_iterator cbegin() const { return m_buffer; }
+  inline const_iterator cend() const { return m_buffer + m_size; }
+  inline const_reverse_iterator crbegin() const {
+    return const_reverse_iterator(end());
+  }
+  inline const_reverse_iterator crend() const {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+  T *inlineBuffer() { return reinterpret_cast<T *>(m_inline); }
+  const T *inlineBuffer() const { return reinterpret_cast<const T *>(m_inline); }
+  bool isInline() const { return m_buffer == inlineBuffer(); }
+
+  template <typename R> static size_type rangeSize(const R &range) {
+    if constexpr (std::ranges::sized_range<R>) {
+      return std::ranges::size(range);
+    } else {
+      return static_cast<size_type>(std::ranges::distance(range));
+    }
+  }
+
+  template <typename It>
+  static void uninitialized_copy_n(It first, size_type n, T *dst) {
+    if constexpr (std::contiguous_iterator<It> &&
+                  std::is_trivially_copyable_v<T>) {
+      if (n != 0) {
+        std::memcpy(dst, std::to_address(first), n * sizeof(T));
+      }
+    } else {
+      std::uninitialized_copy_n(first, n, dst);
+    }
+  }
+
+  void grow(size_type newCapacity) {
+    assert(newCapacity > m_capacity);
+    if constexpr (ReAllocator<A> && is_trivially_relocatable_v<T>) {
+      if (!isInline()) {
+        T *buffer = ATraits::template reallocate<T>(m_allocator, m_buffer,
+                                                    m_capacity, newCapacity);
+        assert(buffer != nullptr);
+        m_buffer = buffer;
+        m_capacity = newCapacity;
+        return;
+      }
+    }
+    auto [buffer, capacity] =
+        ATraits::template allocate_at_least<T>(m_allocator, newCapacity);
+    assert(buffer != nullptr);
+    relocate_n(m_buffer, m_size, buffer);
+    release();
+    m_buffer = buffer;
+    m_capacity = capacity;
+  }
+
+  template <typename... Args> T &emplace_back_grow(Args &&...args) {
+    auto [buffer, capacity] =
+        ATraits::template allocate_at_least<T>(m_allocator, m_capacity * 2);
+    assert(buffer != nullptr);
+    std::construct_at(buffer + m_size, std::forward<Args>(args)...);
+    relocate_n(m_buffer, m_size, buffer);
+    release();
+    m_buffer = buffer;
+    m_capacity = capacity;
+    return m_buffer[m_size++];
+  }
+
+  // Shifts the elements [index, m_size) n slots to the back, leaving
+  // [index, index + n) uninitialized. Requires m_size + n <= m_capacity.
+  void openGap(size_type index, size_type n) {
+    assert(m_size + n <= m_capacity);
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(m_buffer + index + n), m_buffer + index,
+                   (m_size - index) * sizeof(T));
+    } else {
+      for (size_type i = m_size; i-- > index;) {
+        relocate_at(m_buffer + i, m_buffer + i + n);
+      }
+    }
+  }
+
+  // Shifts the elements [index + n, m_size) n slots to the front, the
+  // elements [index, index + n) have to be destructed already.
+  void closeGap(size_type index, size_type n) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(m_buffer + index), m_buffer + index + n,
+                   (m_size - index - n) * sizeof(T));
+    } else {
+      for (size_type i = index + n; i < m_size; ++i) {
+        relocate_at(m_buffer + i, m_buffer + i - n);
+      }
+    }
+  }
+
+  // Releases the allocated buffer, the elements have to be destructed or
+  // relocated already.
+  void release() {
+    if (!isInline()) {
+      ATraits::template deallocate<T>(m_allocator, m_buffer, m_capacity);
+      m_buffer = inlineBuffer();
+      m_capacity = N;
+    }
+  }
+
+  T *m_buffer;
+  size_type m_size;
+  size_type m_capacity;
+  alignas(T) std::byte m_inline[N * sizeof(T)];
+  [[no_unique_address]] A m_allocator;
+};
+
+static_assert(strobe::Container<SmallVector<int, 4>>);
+static_assert(strobe::RandomAccessContainer<SmallVector<int, 4>>);
+static_assert(strobe::StackLikeContainer<SmallVector<int, 4>>);
+static_assert(strobe::SetLikeContainer<SmallVector<int, 4>>);
+static_assert(strobe::QueueLikeContainer<SmallVector<int, 4>>);
+static_assert(strobe::ContainerSupportsInsertion<SmallVector<int, 4>>);
+static_assert(strobe::ContainerSupportsRangeInsertion<SmallVector<int, 4>,
+                                                      SmallVector<int, 4>>);
+static_assert(std::ranges::contiguous_range<SmallVector<int, 4>>);
+
+} // namespace strobe
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "sync/cache_line.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace strobe {
+
+/// Bounded lock-free single-producer / single-consumer FIFO queue.
+/// The elements live in a ring buffer of a power of two capacity, which is
+/// allocated from A (e.g. a PageAllocator for huge rings).
+///
+/// head and tail are monotonic counters, which are each written by only one
+/// side and live on separate cache lines. Both sides additionally keep a
+/// cached copy of the counter of the other side, which is only reloaded if
+/// the ring looks full (or empty), such that in the steady state no cache
+/// line is shared between producer and consumer.
+///
+/// enqueue, try_enqueue and enqueue_bulk must only be called by the
+/// producer, dequeue, try_dequeue, dequeue_bulk and peek only by the
+/// consumer. enqueue and dequeue wait (yield) until the ring has space or
+/// elements.
+template <typename T, Allocator A = strobe::Mallocator> class SpscQueue {
+public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = std::size_t;
+  using allocator_type = A;
+
+  static constexpr size_type DefaultCapacity = 1024;
+
+  /// Capacity is rounded up to the next power of two.
+  explicit SpscQueue(size_type capacity = DefaultCapacity,
+                     const A &allocator = {})
+      : m_buffer(nullptr),
+        m_mask(std::bit_ceil(std::max<size_type>(capacity, 2)) - 1),
+        m_allocator(allocator) {
+    m_buffer = static_cast<T *>(AllocatorTraits<A>::allocate(
+        m_allocator, (m_mask + 1) * sizeof(T), BufferAlignment));
+    assert(m_buffer != nullptr);
+  }
+
+  ~SpscQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const size_type tail = m_tail.load(std::memory_order_acquire);
+      for (size_type i = m_head.load(std::memory_order_relaxed); i != tail;
+           ++i) {
+        std::destroy_at(slot(i));
+      }
+    }
+    AllocatorTraits<A>::deallocate(m_allocator, m_buffer,
+                                   (m_mask + 1) * sizeof(T), BufferAlignment);
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+  SpscQueue(SpscQueue &&) = delete;
+  SpscQueue &operator=(SpscQueue &&) = delete;
+
+  // ---------------------------- producer ---------------------------------
+
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    const size_type tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead > m_mask) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_cachedHead > m_mask) {
+        return false;
+      }
+    }
+    std::construct_at(slot(tail), std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_enqueue(const value_type &v) { return try_emplace(v); }
+  bool try_enqueue(value_type &&v) { return try_emplace(std::move(v)); }
+
+  template <typename... Args> void emplace(Args &&...args) {
+    // try_emplace only consumes the arguments on success.
+    while (!try_emplace(std::forward<Args>(args)...)) {
+      std::this_thread::yield();
+    }
+  }
+  void enqueue(const value_type &v) {
+    while (!try_enqueue(v)) {
+      std::this_thread::yield();
+    }
+  }
+  void enqueue(value_type &&v) {
+    while (!try_enqueue(std::move(v))) {
+      std::this_thread::yield();
+    }
+  }
+
+  /// Copies a prefix of values into the ring, which is published with a
+  /// single store. Returns the length of the prefix.
+  size_type enqueue_bulk(std::span<const value_type> values) {
+    const size_type tail = m_tail.load(std::memory_order_relaxed);
+    size_type free = capacity() - (tail - m_cachedHead);
+    if (free < values.size()) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      free = capacity() - (tail - m_cachedHead);
+    }
+    const size_type n = std::min(free, values.size());
+    // The free slots are split in at most two chunks by the end of the ring.
+    const size_type first = std::min(n, capacity() - (tail & m_mask));
+    std::uninitialized_copy_n(values.data(), first, slot(tail));
+    std::uninitialized_copy_n(values.data() + first, n - first, m_buffer);
+    m_tail.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // ---------------------------- consumer ---------------------------------
+
+  std::optional<value_type> try_dequeue() {
+    const size_type head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head == m_cachedTail) {
+        return std::nullopt;
+      }
+    }
+    std::optional<value_type> value{std::in_place, std::move(*slot(head))};
+    std::destroy_at(slot(head));
+    m_head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  value_type dequeue() {
+    while (true) {
+      if (std::optional<value_type> value = try_dequeue()) {
+        return std::move(*value);
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /// Moves up to out.size() elements into out. Returns the amount of
+  /// dequeued elements.
+  size_type dequeue_bulk(std::span<value_type> out) {
+    const size_type head = m_head.load(std::memory_order_relaxed);
+    if (m_cachedTail - head < out.size()) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+    }
+    const size_type n = std::min(m_cachedTail - head, out.size());
+    const size_type first = std::min(n, capacity() - (head & m_mask));
+    std::move(slot(head), slot(head) + first, out.data());
+    std::move(m_buffer, m_buffer + (n - first), out.data() + first);
+    std::destroy_n(slot(head), first);
+    std::destroy_n(m_buffer, n - first);
+    m_head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  /// Oldest element, the queue must not be empty.
+  const_reference peek() const {
+    const size_type head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+    }
+    assert(head != m_cachedTail);
+    return *slot(head);
+  }
+
+  // ------------------------------------------------------------------------
+
+  /// Exact only if called by the producer or the consumer, otherwise a
+  /// snapshot.
+  size_type size() const {
+    const size_type head = m_head.load(std::memory_order_acquire);
+    return m_tail.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_type capacity() const { return m_mask + 1; }
+
+  allocator_type get_allocator() const { return m_allocator; }
+
+private:
+  static constexpr std::size_t BufferAlignment =
+      std::max(alignof(T), cache_line_size);
+
+  T *slot(size_type i) const { return m_buffer + (i & m_mask); }
+
+  // Written by the consumer.
+  alignas(cache_line_size) std::atomic<size_type> m_head{0};
+  mutable size_type m_cachedTail{0};
+  // Written by the producer.
+  alignas(cache_line_size) std::atomic<size_type> m_tail{0};
+  size_type m_cachedHead{0};
+  // Read only.
+  alignas(cache_line_size) T *m_buffer;
+  size_type m_mask;
+  [[no_unique_address]] A m_allocator;
+};
+
+} // namespace strobe
@@ -0,0 +1,439 @@
+#pragma once
+
+#include "container/container_concepts.hpp"
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+namespace strobe {
+
+/// Vector with stable pointers and iterators.
+/// Elements are stored in segments, where the k-th segment holds
+/// FirstSegmentSize * 2^k elements. Growing allocates a new segment and never
+/// moves any element, pointers and references stay valid until the element
+/// is removed (also if the StableVector itself is moved).
+/// The segment of a index is computed with a single bit_width, the segment
+/// table is stored inline.
+template <typename T, Allocator A = strobe::Mallocator,
+          std::size_t FirstSegmentSize = 16>
+class StableVector {
+  using ATraits = AllocatorTraits<A>;
+  static_assert(std::has_single_bit(FirstSegmentSize));
+
+  static constexpr std::size_t LogFirstSegmentSize =
+      std::countr_zero(FirstSegmentSize);
+  static constexpr std::size_t MaxSegmentCount =
+      std::numeric_limits<std::size_t>::digits - LogFirstSegmentSize;
+
+  template <bool Const> class Iterator {
+    using Owner = std::conditional_t<Const, const StableVector, StableVector>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    Iterator() = default;
+    Iterator(Owner *owner, std::size_t index) : m_owner(owner), m_index(index) {}
+    operator Iterator<true>() const
+      requires(!Const)
+    {
+      return Iterator<true>(m_owner, m_index);
+    }
+
+    reference operator*() const { return (*m_owner)[m_index]; }
+    pointer operator->() const { return &(*m_owner)[m_index]; }
+    reference operator[](difference_type n) const {
+      return (*m_owner)[m_index + n];
+    }
+
+    Iterator &operator++() {
+      ++m_index;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator it = *this;
+      ++m_index;
+      return it;
+    }
+    Iterator &operator--() {
+      --m_index;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator it = *this;
+      --m_index;
+      return it;
+    }
+    Iterator &operator+=(difference_type n) {
+      m_index += n;
+      return *this;
+    }
+    Iterator &operator-=(difference_type n) {
+      m_index -= n;
+      return *this;
+    }
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator &a, const Iterator &b) {
+      return static_cast<difference_type>(a.m_index) -
+             static_cast<difference_type>(b.m_index);
+    }
+    friend bool operator==(const Iterator &a, const Iterator &b) {
+      return a.m_index == b.m_index;
+    }
+    friend auto operator<=>(const Iterator &a, const Iterator &b) {
+      return a.m_index <=> b.m_index;
+    }
+
+  private:
+    friend class StableVector;
+    Owner *m_owner = nullptr;
+    std::size_t m_index = 0;
+  };
+
+public:
+  using value_type = T;
+  using allocator_type = A;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = ATraits::template pointer<value_type>;
+  using const_pointer = ATraits::template const_pointer<value_type>;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // =================== Constructors =======================
+  explicit StableVector(const A &alloc = {})
+      : m_size(0), m_segmentCount(0), m_segments{}, m_allocator(alloc) {}
+
+  explicit StableVector(size_type size, const A &alloc = {})
+    requires std::is_default_constructible_v<T>
+      : StableVector(alloc) {
+    resize(size);
+  }
+
+  explicit StableVector(size_type size, const T &value, const A &alloc = {})
+      : StableVector(alloc) {
+    resize(size, value);
+  }
+
+  template <std::ranges::range Rg>
+    requires(std::same_as<std::ranges::range_value_t<Rg>, value_type>)
+  explicit StableVector(const Rg &rg, const A &alloc = {})
+      : StableVector(alloc) {
+    if constexpr (std::ranges::sized_range<Rg>) {
+      reserve(std::ranges::size(rg));
+    }
+    for (const T &v : rg) {
+      push_back(v);
+    }
+  }
+
+  ~StableVector() { reset(); }
+
+  StableVector(const StableVector &o)
+      : StableVector(
+            ATraits::select_on_container_copy_construction(o.m_allocator)) {
+    reserve(o.m_size);
+    for (const T &v : o) {
+      push_back(v);
+    }
+  }
+
+  StableVector &operator=(const StableVector &o) {
+    if (this == &o) {
+      return *this;
+    }
+    if (ATraits::propagate_on_container_copy_assignment &&
+        !strobe::alloc_equals(m_allocator, o.m_allocator)) {
+      reset();
+      m_allocator = o.m_allocator;
+    } else {
+      clear();
+    }
+    reserve(o.m_size);
+    for (const T &v : o) {
+      push_back(v);
+    }
+    return *this;
+  }
+
+  StableVector(StableVector &&o) noexcept
+      : m_size(std::exchange(o.m_size, 0)),
+        m_segmentCount(std::exchange(o.m_segmentCount, 0)),
+        m_segments(std::exchange(o.m_segments, {})),
+        m_allocator(std::move(o.m_allocator)) {}
+
+  StableVector &operator=(StableVector &&o) noexcept {
+    if (this == &o) {
+      return *this;
+    }
+    if (ATraits::propagate_on_container_move_assignment ||
+        strobe::alloc_equals(m_allocator, o.m_allocator)) {
+      // Safe to take over the segments directly.
+      reset();
+      if (ATraits::propagate_on_container_move_assignment) {
+        m_allocator = std::move(o.m_allocator);
+      }
+      m_size = std::exchange(o.m_size, 0);
+      m_segmentCount = std::exchange(o.m_segmentCount, 0);
+      m_segments = std::exchange(o.m_segments, {});
+    } else {
+      clear();
+      reserve(o.m_size);
+      for (T &v : o) {
+        push_back(std::move(v));
+      }
+      o.reset();
+    }
+    return *this;
+  }
+
+  // ===================== Vector-Interface ===================
+
+  T &operator[](size_type i) {
+    assert(i < m_size);
+    const auto [segment, offset] = locate(i);
+    return m_segments[segment][offset];
+  }
+
+  const T &operator[](size_type i) const {
+    assert(i < m_size);
+    const auto [segment, offset] = locate(i);
+    return m_segments[segment][offset];
+  }
+
+  void push_back(const T &value) { emplace_back(value); }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    const auto [segment, offset] = locate(m_size);
+    if (segment == m_segmentCount) [[unlikely]] {
+      allocateSegment();
+    }
+    T *ptr = std::construct_at(m_segments[segment] + offset,
+                               std::forward<Args>(args)...);
+    ++m_size;
+    return *ptr;
+  }
+
+  void pop_back() {
+    assert(m_size != 0);
+    --m_size;
+    const auto [segment, offset] = locate(m_size);
+    std::destroy_at(m_segments[segment] + offset);
+  }
+
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      forEachSegment(0, m_size, [](T *first, size_type n) {
+        std::destroy_n(first, n);
+      });
+    }
+    m_size = 0;
+  }
+
+  size_type size() const { return m_size; }
+
+  size_type capacity() const { return segmentStart(m_segmentCount); }
+
+  bool empty() const { return m_size == 0; }
+
+  void reserve(size_type newCapacity) {
+    while (capacity() < newCapacity) {
+      allocateSegment();
+    }
+  }
+
+  void resize(size_type newSize, const T &value) {
+    if (newSize < m_size) {
+      shrink(newSize);
+    } else if (newSize > m_size) {
+      reserve(newSize);
+      forEachSegment(m_size, newSize, [&](T *first, size_type n) {
+        std::uninitialized_fill_n(first, n, value);
+      });
+      m_size = newSize;
+    }
+  }
+
+  void resize(size_type newSize)
+    requires(std::is_default_constructible_v<T>)
+  {
+    if (newSize < m_size) {
+      shrink(newSize);
+    } else if (newSize > m_size) {
+      reserve(newSize);
+      forEachSegment(m_size, newSize, [](T *first, size_type n) {
+        std::uninitialized_value_construct_n(first, n);
+      });
+      m_size = newSize;
+    }
+  }
+
+  T &back() {
+    assert(m_size != 0);
+    return (*this)[m_size - 1];
+  }
+  const T &back() const {
+    assert(m_size != 0);
+    return (*this)[m_size - 1];
+  }
+
+  T &front() {
+    assert(m_size != 0);
+    return m_segments[0][0];
+  }
+  const T &front() const {
+    assert(m_size != 0);
+    return m_segments[0][0];
+  }
+
+  // ================= Stack Interface ==============
+  inline void push(const T &value) { push_back(value); }
+  inline T &top() { return back(); }
+  inline const T &top() const { return back(); }
+  inline void pop() { pop_back(); }
+
+  // ================= Set Interface ================
+  inline bool contains(const T &value) const {
+    const auto e = cend();
+    return std::find(cbegin(), e, value) != e;
+  }
+  inline bool add(const T &value) {
+    if (contains(value)) {
+      return false;
+    } else {
+      push_back(value);
+      return true;
+    }
+  }
+  // NOTE: The order of elements is undefined after removing an element.
+  inline bool remove(const T &value) {
+    const auto e = end();
+    auto it = std::find(begin(), e, value);
+    if (it == e) {
+      return false;
+    }
+    if (it != e - 1) {
+      *it = std::move(back());
+    }
+    pop_back();
+    return true;
+  }
+
+  // ================= Range Interface ===============
+  inline iterator begin() { return iterator(this, 0); }
+  inline const_iterator begin() const { return const_iterator(this, 0); }
+  inline iterator end() { return iterator(this, m_size); }
+  inline const_iterator end() const { return const_iterator(this, m_size); }
+  inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+  inline reverse_iterator rend() { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  inline const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  inline const_iterator cbegin() const { return begin(); }
+  inline const_iterator cend() const { return end(); }
+  inline const_reverse_iterator crbegin() const { return rbegin(); }
+  inline const_reverse_iterator crend() const { return rend(); }
+
+private:
+  struct Location {
+    size_type segment;
+    size_type offset;
+  };
+
+  // Segment k covers the indices [F * (2^k - 1), F * (2^(k+1) - 1)), where F
+  // is the FirstSegmentSize, i.e. index + F lies in [F * 2^k, F * 2^(k+1)).
+  static Location locate(size_type index) {
+    const size_type biased = index + FirstSegmentSize;
+    const size_type segment = std::bit_width(biased) - 1 - LogFirstSegmentSize;
+    return {segment, biased - (FirstSegmentSize << segment)};
+  }
+
+  static constexpr size_type segmentSize(size_type segment) {
+    return FirstSegmentSize << segment;
+  }
+
+  static constexpr size_type segmentStart(size_type segment) {
+    return FirstSegmentSize * ((size_type(1) << segment) - 1);
+  }
+
+  void allocateSegment() {
+    assert(m_segmentCount < MaxSegmentCount);
+    T *segment = ATraits::template allocate<T>(m_allocator,
+                                               segmentSize(m_segmentCount));
+    assert(segment != nullptr);
+    m_segments[m_segmentCount++] = segment;
+  }
+
+  // Calls f(first, n) for every contiguous run of the elements [begin, end).
+  template <typename F> void forEachSegment(size_type begin, size_type end, F f) {
+    while (begin < end) {
+      const auto [segment, offset] = locate(begin);
+      const size_type n =
+          std::min(segmentSize(segment) - offset, end - begin);
+      f(m_segments[segment] + offset, n);
+      begin += n;
+    }
+  }
+
+  void shrink(size_type newSize) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      forEachSegment(newSize, m_size, [](T *first, size_type n) {
+        std::destroy_n(first, n);
+      });
+    }
+    m_size = newSize;
+  }
+
+  void reset() {
+    clear();
+    for (size_type s = 0; s < m_segmentCount; ++s) {
+      ATraits::template deallocate<T>(m_allocator, m_segments[s],
+                                      segmentSize(s));
+      m_segments[s] = nullptr;
+    }
+    m_segmentCount = 0;
+  }
+
+  size_type m_size;
+  size_type m_segmentCount;
+  std::array<T *, MaxSegmentCount> m_segments;
+  [[no_unique_address]] A m_allocator;
+};
+
+template <typename T, typename A, std::size_t FirstSegmentSize>
+struct is_trivially_relocatable<StableVector<T, A, FirstSegmentSize>>
+    : is_trivially_relocatable<A> {};
+
+static_assert(strobe::Container<StableVector<int>>);
+static_assert(strobe::RandomAccessContainer<StableVector<int>>);
+static_assert(strobe::StackLikeContainer<StableVector<int>>);
+static_assert(strobe::SetLikeContainer<StableVector<int>>);
+static_assert(std::ranges::random_access_range<StableVector<int>>);
+
+} // namespace strobe
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include "sync/cache_line.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace strobe {
+
+namespace detail {
+
+template <typename T> struct TreiberNode {
+  std::atomic<TreiberNode *> next;
+  union {
+    T value;
+  };
+  TreiberNode() : next(nullptr) {}
+  ~TreiberNode() {}
+};
+
+// Pointer to a node and a modification counter packed into a single word,
+// i.e. a lock-free 64-bit CAS covers both.
+// NOTE: Relies on user space addresses fitting into the lower 48 bits, which
+// holds on x86-64 and AArch64 (unless mappings above 2^47 are requested
+// explicitly).
+template <typename Node> class TaggedNodePtr {
+  static constexpr unsigned PointerBits = 48;
+  static constexpr std::uint64_t PointerMask =
+      (std::uint64_t(1) << PointerBits) - 1;
+
+public:
+  TaggedNodePtr() = default;
+  TaggedNodePtr(Node *node, std::uint64_t tag)
+      : m_bits(reinterpret_cast<std::uintptr_t>(node) |
+               (tag << PointerBits)) {
+    assert((reinterpret_cast<std::uintptr_t>(node) & ~PointerMask) == 0);
+  }
+
+  Node *node() const { return reinterpret_cast<Node *>(m_bits & PointerMask); }
+  std::uint64_t tag() const { return m_bits >> PointerBits; }
+
+private:
+  std::uint64_t m_bits = 0;
+};
+
+// Lock-free LIFO list of nodes. Every successful CAS increments the tag of
+// the head, such that a CAS based on a stale head fails even if the same
+// node is on top again (ABA).
+template <typename Node> class TaggedNodeList {
+public:
+  void push(Node *node) {
+    TaggedNodePtr<Node> head = m_head.load(std::memory_order_relaxed);
+    do {
+      node->next.store(head.node(), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(
+        head, TaggedNodePtr<Node>(node, head.tag() + 1),
+        std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  Node *pop() {
+    TaggedNodePtr<Node> head = m_head.load(std::memory_order_acquire);
+    while (head.node() != nullptr) {
+      // The node might be popped (and pushed again) concurrently, next is
+      // then stale, but nodes are never freed while the list is in use and
+      // the CAS fails because of the tag.
+      Node *next = head.node()->next.load(std::memory_order_relaxed);
+      if (m_head.compare_exchange_weak(head, TaggedNodePtr<Node>(next,
+                                                                 head.tag() + 1),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+        return head.node();
+      }
+    }
+    return nullptr;
+  }
+
+  bool empty() const {
+    return m_head.load(std::memory_order_relaxed).node() == nullptr;
+  }
+
+private:
+  std::atomic<TaggedNodePtr<Node>> m_head{};
+  static_assert(std::atomic<TaggedNodePtr<Node>>::is_always_lock_free);
+};
+
+} // namespace detail
+
+/// Lock-free LIFO stack (Treiber) with ABA protection through tagged head
+/// pointers.
+/// Nodes are recycled through a second lock-free list and only returned to A
+/// on destruction, such that a thread may still read a node after another
+/// thread popped it. Nodes are allocated from A in blocks of BlockNodes,
+/// which is the only place where a (rarely contended) lock is taken.
+template <typename T, Allocator A = strobe::Mallocator,
+          std::size_t BlockNodes = 256>
+class TreiberStack {
+  using Node = detail::TreiberNode<T>;
+
+  // Every block of nodes starts with a header, which chains it to the
+  // previously allocated block.
+  struct BlockHeader {
+    BlockHeader *next;
+  };
+  static constexpr std::size_t BlockHeaderSize =
+      (sizeof(BlockHeader) + alignof(Node) - 1) / alignof(Node) *
+      alignof(Node);
+  static constexpr std::size_t BlockSize =
+      BlockHeaderSize + BlockNodes * sizeof(Node);
+  static constexpr std::size_t BlockAlignment =
+      std::max(alignof(Node), alignof(BlockHeader));
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = A;
+
+  explicit TreiberStack(const A &allocator = {})
+      : m_allocator(allocator), m_blocks(nullptr) {}
+
+  ~TreiberStack() {
+    while (try_pop().has_value()) {
+    }
+    BlockHeader *block = m_blocks;
+    while (block != nullptr) {
+      BlockHeader *next = block->next;
+      AllocatorTraits<A>::deallocate(m_allocator, block, BlockSize,
+                                     BlockAlignment);
+      block = next;
+    }
+  }
+
+  TreiberStack(const TreiberStack &) = delete;
+  TreiberStack &operator=(const TreiberStack &) = delete;
+  TreiberStack(TreiberStack &&) = delete;
+  TreiberStack &operator=(TreiberStack &&) = delete;
+
+  template <typename... Args> void emplace(Args &&...args) {
+    Node *node = m_free.pop();
+    if (node == nullptr) {
+      node = allocate_block();
+    }
+    std::construct_at(&node->value, std::forward<Args>(args)...);
+    m_stack.push(node);
+  }
+  void push(const value_type &v) { emplace(v); }
+  void push(value_type &&v) { emplace(std::move(v)); }
+
+  std::optional<value_type> try_pop() {
+    Node *node = m_stack.pop();
+    if (node == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<value_type> value{std::in_place, std::move(node->value)};
+    std::destroy_at(&node->value);
+    m_free.push(node);
+    return value;
+  }
+
+  /// Snapshot, only exact if no other thread modifies the stack.
+  bool empty() const { return m_stack.empty(); }
+
+  allocator_type get_allocator() const { return m_allocator; }
+
+private:
+  // Allocates a new block, all but the returned node are added to the free
+  // list.
+  Node *allocate_block() {
+    std::byte *raw;
+    {
+      std::lock_guard lock{m_blockMutex};
+      raw = static_cast<std::byte *>(AllocatorTraits<A>::allocate(
+          m_allocator, BlockSize, BlockAlignment));
+      assert(raw != nullptr);
+      m_blocks = std::construct_at(reinterpret_cast<BlockHeader *>(raw),
+                                   BlockHeader{m_blocks});
+    }
+    Node *nodes = reinterpret_cast<Node *>(raw + BlockHeaderSize);
+    for (std::size_t i = 1; i < BlockNodes; ++i) {
+      m_free.push(std::construct_at(nodes + i));
+    }
+    return std::construct_at(nodes);
+  }
+
+  alignas(cache_line_size) detail::TaggedNodeList<Node> m_stack;
+  alignas(cache_line_size) detail::TaggedNodeList<Node> m_free;
+  alignas(cache_line_size) std::mutex m_blockMutex;
+  [[no_unique_address]] A m_allocator;
+  BlockHeader *m_blocks;
+};
+
+} // namespace strobe
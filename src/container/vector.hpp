@@ -3,6 +3,7 @@
 #include "container/container_concepts.hpp"
 #include "memory/AllocatorTraits.hpp"
 #include "memory/Mallocator.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
 #include "type_traits/trivially_destructible_after_move.hpp"
 #include <algorithm>
 #include <cassert>
@@ -10,6 +11,7 @@
 #include <iterator>
 #include <memory>
 #include <ranges>
+#include <tuple>
 #include <type_traits>
 namespace strobe {
 
@@ -169,6 +171,8 @@ public:
       } else {
         destructive_move_assign_from(o.m_buffer, o.m_size);
       }
+      // NOTE: The elements of o are already destructed.
+      o.m_size = 0;
       o.reset();
     }
     return *this;
@@ -226,12 +230,12 @@ public:
 
   void pop_front() {
     assert(m_size != 0);
-    if constexpr (std::is_trivially_copyable_v<T>) {
-      std::memmove(m_buffer, m_buffer + 1, (m_size - 1) * sizeof(T));
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::destroy_at(m_buffer);
+      std::memmove(static_cast<void *>(m_buffer), m_buffer + 1,
+                   (m_size - 1) * sizeof(T));
     } else {
       std::move(m_buffer + 1, m_buffer + m_size, m_buffer);
-    }
-    if (!std::is_trivially_destructible_v<T>) {
       std::destroy_at(m_buffer + m_size - 1);
     }
     --m_size;
@@ -250,6 +254,8 @@ public:
 
   bool empty() const { return m_size == 0; }
 
+  const A &get_allocator() const { return m_allocator; }
+
   void reserve(size_type newCapacity) {
     if (newCapacity > m_capacity) {
       grow(newCapacity);
@@ -318,9 +324,9 @@ public:
       assert(newCapacity > m_capacity);
       T *old = m_buffer;
       size_type oldCapacity = m_capacity;
-      m_buffer = ATraits::template allocate<T>(m_allocator, newCapacity);
-      assert(m_capacity == 0 || m_buffer != nullptr);
-      m_capacity = newCapacity;
+      std::tie(m_buffer, m_capacity) =
+          ATraits::template allocate_at_least<T>(m_allocator, newCapacity);
+      assert(m_buffer != nullptr);
       if (old != nullptr) {
         destructive_move_construct_from_helper(
             m_buffer, old, index); // copy first index elements (does not
@@ -333,9 +339,9 @@ public:
         ATraits::template deallocate<T>(m_allocator, old, oldCapacity);
       }
     } else {
-      if constexpr (std::is_trivially_move_constructible_v<T>) {
-        std::memmove(m_buffer + index + 1, m_buffer + index,
-                     (m_size - index) * sizeof(T));
+      if constexpr (is_trivially_relocatable_v<T>) {
+        std::memmove(static_cast<void *>(m_buffer + index + 1),
+                     m_buffer + index, (m_size - index) * sizeof(T));
       } else {
         std::move_backward(m_buffer + index, m_buffer + m_size,
                            m_buffer + m_size + 1);
@@ -403,8 +409,8 @@ public:
       T *oldBuf = m_buffer;
       const size_type oldCap = m_capacity;
 
-      m_buffer = ATraits::template allocate<T>(m_allocator, newCap);
-      m_capacity = newCap;
+      std::tie(m_buffer, m_capacity) =
+          ATraits::template allocate_at_least<T>(m_allocator, newCap);
       assert(m_buffer != nullptr);
 
       if (oldBuf == nullptr) {
@@ -418,9 +424,9 @@ public:
         ATraits::template deallocate<T>(m_allocator, oldBuf, oldCap);
       }
     } else {
-      if constexpr (std::is_trivially_move_constructible_v<T>) {
-        std::memmove(m_buffer + index + n, m_buffer + index,
-                     (m_size - index) * sizeof(T));
+      if constexpr (is_trivially_relocatable_v<T>) {
+        std::memmove(static_cast<void *>(m_buffer + index + n),
+                     m_buffer + index, (m_size - index) * sizeof(T));
       } else {
         std::move_backward(m_buffer + index, m_buffer + m_size,
                            m_buffer + m_size + n);
@@ -505,11 +511,25 @@ public:
 private:
   void grow(size_type newCapacity) {
     assert(newCapacity > m_capacity);
+    if constexpr (ReAllocator<A> && is_trivially_relocatable_v<T>) {
+      // NOTE: The allocator might be able to grow the buffer in place (or
+      // remap it), which avoids touching the elements at all.
+      if (m_buffer != nullptr) {
+        T *buffer = ATraits::template reallocate<T>(m_allocator, m_buffer,
+                                                    m_capacity, newCapacity);
+        assert(buffer != nullptr);
+        m_buffer = buffer;
+        m_capacity = newCapacity;
+        return;
+      }
+    }
     T *old = m_buffer;
     size_type oldCapacity = m_capacity;
-    m_buffer = ATraits::template allocate<T>(m_allocator, newCapacity);
-    assert(m_capacity == 0 || m_buffer != nullptr);
-    m_capacity = newCapacity;
+    // NOTE: Take all of the memory the allocator hands out.
+    std::tie(m_buffer, m_capacity) =
+        ATraits::template allocate_at_least<T>(m_allocator, newCapacity);
+    assert(m_buffer != nullptr);
+    assert(m_capacity >= newCapacity);
     if (old != nullptr) {
       destructive_move_construct_from(old, m_size);
       ATraits::template deallocate<T>(m_allocator, old, oldCapacity);
@@ -552,26 +572,17 @@ private:
         std::destroy(m_buffer + size, m_buffer + m_size);
       } else {
         std::copy(source, source + m_size, m_buffer);
-        std::uninitialized_copy(source + m_size, source + size, m_buffer);
+        std::uninitialized_copy(source + m_size, source + size,
+                                m_buffer + m_size);
       }
     }
     m_size = size;
   }
   static void destructive_move_construct_from_helper(T *buffer, T *source,
                                                      size_type size) {
-    if constexpr (std::is_trivially_move_constructible_v<T>) {
-      // Trivial objects can be copied with memcpy, which is most likely
-      // faster!
-      std::memcpy(buffer, source, size * sizeof(T));
-    } else {
-      // For non trivial objects we have to call the copy constructor.
-      // Uninitalized copy implies that m_buffer is raw memory and does not
-      // contain any constructed objects (No need to call destructor).
-      std::uninitialized_move(source, source + size, buffer);
-    }
-    if constexpr (!strobe::is_trivially_destructible_after_move_v<T>) {
-      std::destroy(source, source + size);
-    }
+    // NOTE: Trivially relocatable objects are copied with memcpy and the
+    // source is not destructed, otherwise they are moved.
+    relocate_n(source, size, buffer);
   }
 
   void destructive_move_construct_from(T *source, size_type size) {
@@ -581,8 +592,9 @@ private:
 
   void destructive_move_assign_from(T *source, size_type size) {
     assert(m_capacity >= size);
-    if constexpr (std::is_trivially_move_assignable_v<T>) {
-      std::memcpy(m_buffer, source, size * sizeof(T));
+    if constexpr (is_trivially_relocatable_v<T>) {
+      std::destroy(m_buffer, m_buffer + m_size);
+      std::memcpy(static_cast<void *>(m_buffer), source, size * sizeof(T));
     } else {
       if (size <= m_size) {
         // Copy elements (Calls copy assignment operator i.e. destructs
@@ -592,7 +604,8 @@ private:
         std::destroy(m_buffer + size, m_buffer + m_size);
       } else {
         std::move(source, source + m_size, m_buffer);
-        std::uninitialized_move(source + m_size, source + size, m_buffer);
+        std::uninitialized_move(source + m_size, source + size,
+                                m_buffer + m_size);
       }
       if constexpr (!strobe::is_trivially_destructible_after_move_v<T>) {
         std::destroy(source, source + size);
@@ -616,6 +629,9 @@ private:
   [[no_unique_address]] A m_allocator;
 };
 
+template <typename T, typename A>
+struct is_trivially_relocatable<Vector<T, A>> : is_trivially_relocatable<A> {};
+
 static_assert(strobe::Container<Vector<int>>);
 static_assert(strobe::RandomAccessContainer<Vector<int>>);
 static_assert(strobe::StackLikeContainer<Vector<int>>);
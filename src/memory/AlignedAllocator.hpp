@@ -0,0 +1,59 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/Mallocator.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+namespace strobe {
+
+/// Forwards to the upstream allocator, but raises the alignment of every
+/// request to at least Alignment. Used to place containers on cache line
+/// boundaries, without changing the alignment of the element type.
+template <Allocator Upstream = Mallocator, std::size_t Alignment = 64>
+class AlignedAllocator {
+  static_assert(std::has_single_bit(Alignment));
+
+public:
+  static constexpr bool is_always_equal =
+      AllocatorTraits<Upstream>::is_always_equal;
+
+  AlignedAllocator(Upstream upstream = {}) : m_upstream(std::move(upstream)) {}
+
+  void *allocate(std::size_t size, std::size_t align) {
+    return Traits::allocate(m_upstream, size, alignOf(align));
+  }
+
+  void deallocate(void *ptr, std::size_t size, std::size_t align) {
+    Traits::deallocate(m_upstream, ptr, size, alignOf(align));
+  }
+
+  std::pair<void *, std::size_t> allocate_at_least(std::size_t size,
+                                                   std::size_t align)
+    requires OverAllocator<Upstream>
+  {
+    return Traits::allocate_at_least(m_upstream, size, alignOf(align));
+  }
+
+  void *reallocate(void *ptr, std::size_t oldSize, std::size_t newSize,
+                   std::size_t align)
+    requires ReAllocator<Upstream>
+  {
+    return Traits::reallocate(m_upstream, ptr, oldSize, newSize,
+                              alignOf(align));
+  }
+
+private:
+  static constexpr std::size_t alignOf(std::size_t align) {
+    return std::max(align, Alignment);
+  }
+
+  using Traits = AllocatorTraits<Upstream>;
+  [[no_unique_address]] Upstream m_upstream;
+};
+
+static_assert(ReAllocator<AlignedAllocator<>>);
+static_assert(OverAllocator<AlignedAllocator<>>);
+
+} // namespace strobe
@@ -12,7 +12,21 @@ public:
   }
 
   void deallocate(void *ptr, std::size_t size, std::size_t align) {
-    return Traits::free(*m_resource, ptr, size, align);
+    return Traits::deallocate(*m_resource, ptr, size, align);
+  }
+
+  std::pair<void *, std::size_t> allocate_at_least(std::size_t size,
+                                                   std::size_t align)
+    requires OverAllocator<Resource>
+  {
+    return Traits::allocate_at_least(*m_resource, size, align);
+  }
+
+  void *reallocate(void *ptr, std::size_t oldSize, std::size_t newSize,
+                   std::size_t align)
+    requires ReAllocator<Resource>
+  {
+    return Traits::reallocate(*m_resource, ptr, oldSize, newSize, align);
   }
 
   void deallocate(void *ptr)
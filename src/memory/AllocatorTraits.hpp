@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
 #include <utility>
 namespace strobe {
 
@@ -71,8 +75,56 @@ template <Allocator A> struct AllocatorTraits {
     deallocate(a, ptr, n * sizeof(T), alignof(T));
   }
 
-  static std::pair<void *, std::size_t> allocate_at_least(...);
-  static void *reallocate(...);
+  // Allocates at least size bytes and returns the amount of bytes, which are
+  // actually usable. Allocators, which can't report it, return size.
+  static inline std::pair<void *, std::size_t>
+  allocate_at_least(A &a, std::size_t size, std::size_t align) {
+    if constexpr (OverAllocator<A>) {
+      return a.allocate_at_least(size, align);
+    } else {
+      return {a.allocate(size, align), size};
+    }
+  }
+
+  // Resizes the allocation to newSize bytes, preserving the first
+  // min(oldSize, newSize) bytes. Allocators without a native reallocate are
+  // emulated with allocate + memcpy + deallocate.
+  // Returns nullptr on failure, the old allocation stays valid in that case.
+  // newSize must not be 0, allocations are freed with deallocate.
+  static inline void *reallocate(A &a, void *ptr, std::size_t oldSize,
+                                 std::size_t newSize, std::size_t align) {
+    assert(newSize != 0 && "reallocate to 0 bytes, use deallocate");
+    if constexpr (ReAllocator<A>) {
+      return a.reallocate(ptr, oldSize, newSize, align);
+    } else {
+      void *newPtr = a.allocate(newSize, align);
+      if (newPtr == nullptr) {
+        return nullptr;
+      }
+      if (ptr != nullptr) {
+        std::memcpy(newPtr, ptr, std::min(oldSize, newSize));
+        a.deallocate(ptr, oldSize, align);
+      }
+      return newPtr;
+    }
+  }
+
+  // Returns the allocation and the amount of T's which fit into it.
+  template <typename T>
+  static inline std::pair<T *, std::size_t> allocate_at_least(A &a,
+                                                              std::size_t n) {
+    auto [ptr, size] = allocate_at_least(a, n * sizeof(T), alignof(T));
+    return {reinterpret_cast<T *>(ptr), size / sizeof(T)};
+  }
+
+  // NOTE: The elements are moved bytewise, T has to be trivially relocatable.
+  template <typename T>
+  static inline T *reallocate(A &a, T *ptr, std::size_t oldN,
+                              std::size_t newN) {
+    return reinterpret_cast<T *>(reallocate(a, ptr, oldN * sizeof(T),
+                                            newN * sizeof(T), alignof(T)));
+  }
+
   static bool owns(A &a, void *ptr)
     requires OwningAllocator<A>
   {
@@ -114,14 +166,15 @@ private:
                   })
       return static_cast<bool>(U::is_always_equal);
     else
-      return false;
+      return std::is_empty_v<U>;
   }
 
 public:
   static constexpr bool propagate_on_container_copy_assignment =
       pocca_value<A>();
 
-  static constexpr bool propagate_on_container_move_assignment = pomca_value<A>;
+  static constexpr bool propagate_on_container_move_assignment =
+      pomca_value<A>();
 
   static constexpr bool is_always_equal =
       !ComparibleAllocator<A> && is_always_equal_value<A>();
@@ -2,12 +2,15 @@
 
 #include "memory/AllocatorTraits.hpp"
 #include "memory/PageAllocator.hpp"
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <bitset>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <utility>
 
 namespace strobe {
 
@@ -64,7 +67,7 @@ public:
 
   void *allocate(std::size_t size, std::size_t alignment) {
     assert(alignment <= size && std::has_single_bit(alignment));
-    size = std::bit_ceil(size);
+    size = std::bit_ceil(std::max(size, BlockSize));
     if (size == 0 || size > Capacity) {
       return nullptr;
     }
@@ -75,8 +78,18 @@ public:
     return ptr;
   }
 
+  // Reports the power of two block, which is handed out for the request.
+  std::pair<void *, std::size_t> allocate_at_least(std::size_t size,
+                                                   std::size_t alignment) {
+    void *ptr = allocate(size, alignment);
+    if (ptr == nullptr) {
+      return {nullptr, 0};
+    }
+    return {ptr, std::bit_ceil(std::max(size, BlockSize))};
+  }
+
   void deallocate(void *ptr, std::size_t size, std::size_t) {
-    size = std::bit_ceil(size);
+    size = std::bit_ceil(std::max(size, BlockSize));
     if (size == 0 || size > Capacity) {
       throw std::runtime_error("Invalid size for deallocate");
     }
@@ -133,6 +146,8 @@ private:
     m_freelists[order] = next;
     if (next != nullptr) {
       next->prev = nullptr;
+    } else {
+      m_nonEmpty &= ~(std::uint64_t(1) << order);
     }
     // TODO might not be needed
     head->next = nullptr;
@@ -142,14 +157,19 @@ private:
 
   void eraseNodeFromFreelist(FreelistNode *node, int order) {
     if (node->prev == nullptr) {
-      m_freelists[order] = nullptr;
+      m_freelists[order] = node->next;
+      if (node->next == nullptr) {
+        m_nonEmpty &= ~(std::uint64_t(1) << order);
+      }
     } else {
-      FreelistNode *prev = node->prev;
-      prev->next = node->next;
-      // TODO Maybe we don't have to cleanup non used nodes.
-      node->next = nullptr;
-      node->prev = nullptr;
+      node->prev->next = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
     }
+    // TODO Maybe we don't have to cleanup non used nodes.
+    node->next = nullptr;
+    node->prev = nullptr;
   }
 
   static FreelistNode *rightChildOfFreelistNode(FreelistNode *node,
@@ -211,22 +231,20 @@ private:
     }
     node->next = head;
     node->prev = nullptr;
+    m_nonEmpty |= std::uint64_t(1) << order;
   }
 
   void *allocateFromFreelist(const int order) {
-    FreelistNode *node = nullptr;
-    int o = order;
-    while (o >= 0) {
-      node = popFreelist(o);
-      if (node == nullptr) {
-        --o;
-      } else {
-        break;
-      }
-    }
-    if (node == nullptr) {
+    // Nearest non empty order which is not deeper than the requested one,
+    // larger blocks have smaller orders.
+    const std::uint64_t candidates =
+        m_nonEmpty & ((std::uint64_t(2) << order) - 1);
+    if (candidates == 0) {
       return nullptr;
     }
+    int o = floorLog2(candidates);
+    FreelistNode *node = popFreelist(o);
+    assert(node != nullptr);
 
     // Break up blocks
     std::size_t index = freelistPtrToIndex(node, o);
@@ -275,6 +293,11 @@ private:
   std::byte *m_buffer;
   std::array<FreelistNode, BlockCount / 2> m_freelistStorage;
   std::array<FreelistNode *, LogBlockCount + 1> m_freelists;
+  // Bit o is set iff m_freelists[o] is not empty.
+  std::uint64_t m_nonEmpty = 0;
 };
 
+static_assert(OwningAllocator<BuddyResource<1024, 8>>);
+static_assert(OverAllocator<BuddyResource<1024, 8>>);
+
 } // namespace strobe
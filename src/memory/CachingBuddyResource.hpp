@@ -0,0 +1,158 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/BuddyResource.hpp"
+#include "memory/PageAllocator.hpp"
+#include "sync/cache_line.hpp"
+#include "sync/spin_lock.hpp"
+#include "sync/thread_slot.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace strobe {
+
+/// Thread safe front-end for a BuddyResource.
+/// Every thread owns a small magazine of free blocks for each of the
+/// CachedOrders smallest block sizes. Allocations and deallocations are served
+/// from the magazine of the calling thread, only if it runs empty (or
+/// overflows) half a magazine is exchanged with the shared buddy core, which
+/// is guarded by a mutex. Larger blocks always go directly to the core.
+///
+/// Threads are mapped to magazines by this_thread_slot() % SlotCount. Every
+/// magazine is guarded by a SpinLock, which is uncontended as long as there
+/// are no more than SlotCount threads, but keeps the resource correct if
+/// there are.
+/// NOTE: Blocks cached in a magazine are not available to other threads and
+/// can not be coalesced within the core.
+template <std::size_t Capacity, std::size_t BlockSize,
+          typename UpstreamAllocator = PageAllocator,
+          std::size_t MagazineSize = 32, std::size_t CachedOrders = 8,
+          std::size_t SlotCount = 64>
+class CachingBuddyResource {
+  using Core = BuddyResource<Capacity, BlockSize, UpstreamAllocator>;
+
+  static_assert(MagazineSize >= 2);
+  static constexpr std::size_t LogBlockSize = std::bit_width(BlockSize - 1);
+  static constexpr std::size_t LogCapacity = std::bit_width(Capacity - 1);
+  static constexpr std::size_t CachedClasses =
+      std::min(CachedOrders, LogCapacity - LogBlockSize + 1);
+
+  struct alignas(cache_line_size) Magazine {
+    SpinLock lock;
+    std::array<std::uint32_t, CachedClasses> counts{};
+    std::array<std::array<void *, MagazineSize>, CachedClasses> blocks;
+  };
+
+public:
+  explicit CachingBuddyResource(const UpstreamAllocator &upstream = {})
+      : m_core(upstream) {}
+
+  CachingBuddyResource(const CachingBuddyResource &) = delete;
+  CachingBuddyResource &operator=(const CachingBuddyResource &) = delete;
+  CachingBuddyResource(CachingBuddyResource &&) = delete;
+  CachingBuddyResource &operator=(CachingBuddyResource &&) = delete;
+
+  bool owns(const void *p) const { return m_core.owns(p); }
+
+  void *allocate(std::size_t size, std::size_t alignment) {
+    const std::size_t cls = sizeClass(size);
+    if (cls >= CachedClasses) {
+      std::lock_guard lock{m_coreMutex};
+      return m_core.allocate(size, alignment);
+    }
+    Magazine &magazine = localMagazine();
+    std::lock_guard lock{magazine.lock};
+    std::uint32_t &count = magazine.counts[cls];
+    if (count == 0) {
+      count = refill(magazine.blocks[cls].data(), cls);
+      if (count == 0) {
+        return nullptr;
+      }
+    }
+    return magazine.blocks[cls][--count];
+  }
+
+  std::pair<void *, std::size_t> allocate_at_least(std::size_t size,
+                                                   std::size_t alignment) {
+    void *ptr = allocate(size, alignment);
+    if (ptr == nullptr) {
+      return {nullptr, 0};
+    }
+    return {ptr, blockSizeOfClass(sizeClass(size))};
+  }
+
+  void deallocate(void *ptr, std::size_t size, std::size_t alignment) {
+    assert(owns(ptr));
+    const std::size_t cls = sizeClass(size);
+    if (cls >= CachedClasses) {
+      std::lock_guard lock{m_coreMutex};
+      m_core.deallocate(ptr, size, alignment);
+      return;
+    }
+    Magazine &magazine = localMagazine();
+    std::lock_guard lock{magazine.lock};
+    std::uint32_t &count = magazine.counts[cls];
+    if (count == MagazineSize) {
+      count -= flush(magazine.blocks[cls].data() + MagazineSize / 2, cls);
+    }
+    magazine.blocks[cls][count++] = ptr;
+  }
+
+private:
+  // Index of the power of two block, which is used for a allocation of the
+  // given size. 0 is the smallest block (BlockSize).
+  static std::size_t sizeClass(std::size_t size) {
+    const std::size_t block = std::bit_ceil(std::max(size, BlockSize));
+    return std::countr_zero(block) - LogBlockSize;
+  }
+
+  static constexpr std::size_t blockSizeOfClass(std::size_t cls) {
+    return BlockSize << cls;
+  }
+
+  Magazine &localMagazine() {
+    return m_magazines[this_thread_slot() % SlotCount];
+  }
+
+  // Fills the lower half of a empty magazine from the core, returns the
+  // amount of blocks that could be allocated.
+  std::uint32_t refill(void **blocks, std::size_t cls) {
+    const std::size_t size = blockSizeOfClass(cls);
+    std::lock_guard lock{m_coreMutex};
+    std::uint32_t n = 0;
+    while (n < MagazineSize / 2) {
+      void *ptr = m_core.allocate(size, size);
+      if (ptr == nullptr) {
+        break;
+      }
+      blocks[n++] = ptr;
+    }
+    return n;
+  }
+
+  // Returns the upper half of a full magazine to the core.
+  std::uint32_t flush(void **blocks, std::size_t cls) {
+    const std::size_t size = blockSizeOfClass(cls);
+    constexpr std::uint32_t n = MagazineSize - MagazineSize / 2;
+    std::lock_guard lock{m_coreMutex};
+    for (std::uint32_t i = 0; i < n; ++i) {
+      m_core.deallocate(blocks[i], size, size);
+    }
+    return n;
+  }
+
+  std::array<Magazine, SlotCount> m_magazines;
+  alignas(cache_line_size) std::mutex m_coreMutex;
+  Core m_core;
+};
+
+static_assert(OwningAllocator<CachingBuddyResource<1024, 8>>);
+static_assert(OverAllocator<CachingBuddyResource<1024, 8>>);
+
+} // namespace strobe
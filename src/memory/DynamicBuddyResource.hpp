@@ -0,0 +1,413 @@
+#pragma once
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/PageAllocator.hpp"
+#include "memory/align.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace strobe {
+
+/// Buddy allocator with a arena capacity chosen at runtime.
+/// Same algorithm as the BuddyResource, but all metadata (split bitset,
+/// freelist nodes, freelist heads) lives in memory requested from the
+/// upstream allocator, instead of inline in the object.
+/// If all arenas are exhausted a additional arena is mapped from the upstream
+/// allocator. Deallocations are routed to the owning arena by a binary search
+/// over the arenas, which are kept sorted by their address.
+/// NOTE: Arenas are only returned to the upstream allocator on destruction.
+template <std::size_t BlockSize, typename UpstreamAllocator = PageAllocator>
+class DynamicBuddyResource {
+  using UpstreamTraits = AllocatorTraits<UpstreamAllocator>;
+  static_assert(std::has_single_bit(BlockSize));
+
+  static constexpr std::size_t LogBlockSize = std::bit_width(BlockSize - 1);
+
+  struct FreelistNode {
+    FreelistNode *next;
+    FreelistNode *prev;
+  };
+
+  struct Arena {
+    std::byte *buffer;
+    std::uint64_t *bitset;
+    FreelistNode *freelistStorage;
+    FreelistNode **freelists;
+    // Bit o is set iff freelists[o] is not empty.
+    std::uint64_t nonEmpty;
+  };
+
+public:
+  explicit DynamicBuddyResource(std::size_t arenaCapacity,
+                                const UpstreamAllocator &upstream = {})
+      : m_upstream(upstream),
+        m_logCapacity(std::bit_width(
+            std::bit_ceil(std::max(arenaCapacity, BlockSize * 2)) - 1)),
+        m_logBlockCount(m_logCapacity - LogBlockSize), m_arenas(nullptr),
+        m_arenaCount(0), m_arenaCapacity(0), m_current(0) {}
+
+  ~DynamicBuddyResource() {
+    for (std::size_t i = 0; i < m_arenaCount; ++i) {
+      releaseArena(m_arenas[i]);
+    }
+    if (m_arenas != nullptr) {
+      UpstreamTraits::deallocate(m_upstream, m_arenas,
+                                 m_arenaCapacity * sizeof(Arena),
+                                 alignof(Arena));
+      m_arenas = nullptr;
+    }
+  }
+
+  DynamicBuddyResource(const DynamicBuddyResource &) = delete;
+  DynamicBuddyResource &operator=(const DynamicBuddyResource &) = delete;
+  DynamicBuddyResource(DynamicBuddyResource &&o) = delete;
+  DynamicBuddyResource &operator=(DynamicBuddyResource &&o) = delete;
+
+  std::size_t arena_capacity() const { return std::size_t(1) << m_logCapacity; }
+
+  std::size_t arena_count() const { return m_arenaCount; }
+
+  bool owns(const void *p) const { return findArena(p) != nullptr; }
+
+  void *allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment <= size && std::has_single_bit(alignment));
+    size = std::bit_ceil(std::max(size, BlockSize));
+    if (size > arena_capacity()) {
+      return nullptr;
+    }
+    const int order = orderOfSize(size);
+    if (m_arenaCount != 0) {
+      void *ptr = allocateFromFreelist(m_arenas[m_current], order);
+      if (ptr != nullptr) {
+        return ptr;
+      }
+      for (std::size_t i = 0; i < m_arenaCount; ++i) {
+        if (i == m_current) {
+          continue;
+        }
+        ptr = allocateFromFreelist(m_arenas[i], order);
+        if (ptr != nullptr) {
+          m_current = i;
+          return ptr;
+        }
+      }
+    }
+    if (!mapArena()) {
+      return nullptr;
+    }
+    return allocateFromFreelist(m_arenas[m_current], order);
+  }
+
+  // Reports the power of two block, which is handed out for the request.
+  std::pair<void *, std::size_t> allocate_at_least(std::size_t size,
+                                                   std::size_t alignment) {
+    void *ptr = allocate(size, alignment);
+    if (ptr == nullptr) {
+      return {nullptr, 0};
+    }
+    return {ptr, std::bit_ceil(std::max(size, BlockSize))};
+  }
+
+  void deallocate(void *ptr, std::size_t size, std::size_t) {
+    size = std::bit_ceil(std::max(size, BlockSize));
+    Arena *arena = findArena(ptr);
+    if (size > arena_capacity() || arena == nullptr) {
+      throw std::runtime_error("Invalid deallocate");
+    }
+    deallocateToFreelist(*arena, ptr, orderOfSize(size));
+  }
+
+private:
+  int orderOfSize(std::size_t size) const {
+    const std::size_t block = size >> LogBlockSize;
+    return m_logBlockCount - floorLog2(block);
+  }
+
+  std::size_t blockCount() const { return std::size_t(1) << m_logBlockCount; }
+
+  // ================= Arena management ===================
+  std::size_t bitsetWordCount() const { return (blockCount() * 2 + 63) / 64; }
+
+  std::size_t metadataSize() const {
+    std::size_t size = bitsetWordCount() * sizeof(std::uint64_t);
+    size = align_up(size, alignof(FreelistNode));
+    size += (blockCount() / 2) * sizeof(FreelistNode);
+    size += (m_logBlockCount + 1) * sizeof(FreelistNode *);
+    return size;
+  }
+
+  Arena *findArena(const void *p) const {
+    const auto *raw = static_cast<const std::byte *>(p);
+    // First arena which starts after p.
+    Arena *it = std::upper_bound(
+        m_arenas, m_arenas + m_arenaCount, raw,
+        [](const std::byte *ptr, const Arena &a) { return ptr < a.buffer; });
+    if (it == m_arenas) {
+      return nullptr;
+    }
+    --it;
+    if (raw >= it->buffer + arena_capacity()) {
+      return nullptr;
+    }
+    return it;
+  }
+
+  bool mapArena() {
+    if (m_arenaCount == m_arenaCapacity) {
+      const std::size_t newCapacity =
+          m_arenaCapacity == 0 ? 4 : m_arenaCapacity * 2;
+      auto *arenas = static_cast<Arena *>(UpstreamTraits::allocate(
+          m_upstream, newCapacity * sizeof(Arena), alignof(Arena)));
+      if (arenas == nullptr) {
+        return false;
+      }
+      if (m_arenas != nullptr) {
+        std::memcpy(arenas, m_arenas, m_arenaCount * sizeof(Arena));
+        UpstreamTraits::deallocate(m_upstream, m_arenas,
+                                   m_arenaCapacity * sizeof(Arena),
+                                   alignof(Arena));
+      }
+      m_arenas = arenas;
+      m_arenaCapacity = newCapacity;
+    }
+
+    Arena arena;
+    arena.buffer = static_cast<std::byte *>(UpstreamTraits::allocate(
+        m_upstream, arena_capacity(), alignof(std::max_align_t)));
+    if (arena.buffer == nullptr) {
+      return false;
+    }
+    auto *meta = static_cast<std::byte *>(UpstreamTraits::allocate(
+        m_upstream, metadataSize(), alignof(FreelistNode)));
+    if (meta == nullptr) {
+      UpstreamTraits::deallocate(m_upstream, arena.buffer, arena_capacity(),
+                                 alignof(std::max_align_t));
+      return false;
+    }
+    std::size_t offset = bitsetWordCount() * sizeof(std::uint64_t);
+    arena.bitset = reinterpret_cast<std::uint64_t *>(meta);
+    offset = align_up(offset, alignof(FreelistNode));
+    arena.freelistStorage = reinterpret_cast<FreelistNode *>(meta + offset);
+    offset += (blockCount() / 2) * sizeof(FreelistNode);
+    arena.freelists = reinterpret_cast<FreelistNode **>(meta + offset);
+
+    std::memset(arena.bitset, 0, bitsetWordCount() * sizeof(std::uint64_t));
+    for (std::size_t i = 0; i < blockCount() / 2; ++i) {
+      arena.freelistStorage[i] = FreelistNode{nullptr, nullptr};
+    }
+    for (std::size_t o = 0; o <= m_logBlockCount; ++o) {
+      arena.freelists[o] = nullptr;
+    }
+    arena.nonEmpty = 0;
+    pushFreelist(arena, 0, &getFreelistNode(arena, 0, 0));
+
+    // Keep arenas sorted by address for findArena.
+    Arena *pos = std::upper_bound(
+        m_arenas, m_arenas + m_arenaCount, arena.buffer,
+        [](const std::byte *ptr, const Arena &a) { return ptr < a.buffer; });
+    std::memmove(pos + 1, pos,
+                 (m_arenas + m_arenaCount - pos) * sizeof(Arena));
+    *pos = arena;
+    ++m_arenaCount;
+    m_current = pos - m_arenas;
+    return true;
+  }
+
+  void releaseArena(Arena &arena) {
+    UpstreamTraits::deallocate(m_upstream, arena.buffer, arena_capacity(),
+                               alignof(std::max_align_t));
+    UpstreamTraits::deallocate(m_upstream, arena.bitset, metadataSize(),
+                               alignof(FreelistNode));
+  }
+
+  // ================= Buddy algorithm ===================
+  // NOTE: Identical to the BuddyResource, except that the tree depth
+  // (m_logBlockCount) is a runtime value.
+  static constexpr int floorLog2(const std::size_t n) {
+    return std::bit_width(n) - 1;
+  }
+
+  static bool testBit(const Arena &arena, std::size_t index) {
+    return (arena.bitset[index / 64] >> (index % 64)) & 0x1;
+  }
+  static void setBit(Arena &arena, std::size_t index) {
+    arena.bitset[index / 64] |= std::uint64_t(1) << (index % 64);
+  }
+  static void resetBit(Arena &arena, std::size_t index) {
+    arena.bitset[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+  }
+
+  static std::size_t indexOffsetOfOrder(const int order) {
+    return (std::size_t(1) << static_cast<std::size_t>(order)) - 1;
+  }
+  static std::size_t rankOfNodeIndex(const std::size_t nodeIndex,
+                                     const int order) {
+    return nodeIndex - indexOffsetOfOrder(order);
+  }
+  static std::size_t parentOfIndex(const std::size_t index) {
+    return (index - 1) / 2;
+  }
+  static constexpr std::size_t buddyOfIndex(const std::size_t index) {
+    assert(index != 0);
+    if (index & 0x1) { // is left child.
+      return index + 1;
+    }
+    // is right child.
+    return index - 1;
+  }
+
+  FreelistNode &getFreelistNode(Arena &arena, const std::size_t index,
+                                const int order) const {
+    const int L = static_cast<int>(m_logBlockCount);
+    if (order == L) {
+      const std::size_t block = index - indexOffsetOfOrder(order);
+      return arena.freelistStorage[block / 2];
+    }
+    const std::size_t rank = rankOfNodeIndex(index, order);
+    return arena.freelistStorage[rank << (L - order - 1)];
+  }
+
+  FreelistNode *popFreelist(Arena &arena, int order) {
+    FreelistNode *head = arena.freelists[order];
+    if (head == nullptr) {
+      return nullptr;
+    }
+    FreelistNode *next = head->next;
+    arena.freelists[order] = next;
+    if (next != nullptr) {
+      next->prev = nullptr;
+    } else {
+      arena.nonEmpty &= ~(std::uint64_t(1) << order);
+    }
+    head->next = nullptr;
+    head->prev = nullptr;
+    return head;
+  }
+
+  void eraseNodeFromFreelist(Arena &arena, FreelistNode *node, int order) {
+    if (node->prev == nullptr) {
+      arena.freelists[order] = node->next;
+      if (node->next == nullptr) {
+        arena.nonEmpty &= ~(std::uint64_t(1) << order);
+      }
+    } else {
+      node->prev->next = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    }
+    node->next = nullptr;
+    node->prev = nullptr;
+  }
+
+  void pushFreelist(Arena &arena, const int order, FreelistNode *node) {
+    assert(node != nullptr);
+    FreelistNode *head = arena.freelists[order];
+    arena.freelists[order] = node;
+    if (head != nullptr) {
+      head->prev = node;
+    }
+    node->next = head;
+    node->prev = nullptr;
+    arena.nonEmpty |= std::uint64_t(1) << order;
+  }
+
+  FreelistNode *rightChildOfFreelistNode(FreelistNode *node,
+                                         const int order) const {
+    const int L = static_cast<int>(m_logBlockCount);
+    if (order == L - 1) {
+      return node;
+    }
+    return node + (std::size_t(1) << (L - order - 2));
+  }
+
+  std::size_t freelistPtrToIndex(Arena &arena, FreelistNode *node,
+                                 const int order) const {
+    const int L = static_cast<int>(m_logBlockCount);
+    const std::size_t location = node - arena.freelistStorage;
+    const std::size_t offset = indexOffsetOfOrder(order);
+    if (order == L) {
+      // NOTE: Requires bitset because freelist pointers only give us half
+      // resolution!
+      const std::size_t leftIndex = offset + location * 2;
+      if (testBit(arena, leftIndex)) {
+        return leftIndex + 1;
+      }
+      return leftIndex;
+    }
+    return offset + (location >> (L - order - 1));
+  }
+
+  std::size_t ptrToIndex(const Arena &arena, void *ptr,
+                         const int order) const {
+    const auto *raw = static_cast<std::byte *>(ptr);
+    const std::size_t block = (raw - arena.buffer) >> LogBlockSize;
+    const std::size_t rank = block >> (m_logBlockCount - order);
+    return indexOffsetOfOrder(order) + rank;
+  }
+
+  void *allocateFromFreelist(Arena &arena, const int order) {
+    const std::uint64_t candidates =
+        arena.nonEmpty & ((std::uint64_t(2) << order) - 1);
+    if (candidates == 0) {
+      return nullptr;
+    }
+    int o = floorLog2(candidates);
+    FreelistNode *node = popFreelist(arena, o);
+    assert(node != nullptr);
+
+    // Break up blocks
+    std::size_t index = freelistPtrToIndex(arena, node, o);
+    const std::size_t rank = rankOfNodeIndex(index, o);
+    const std::size_t ptrOffset = (rank << (m_logBlockCount - o))
+                                  << LogBlockSize;
+    setBit(arena, index);
+    while (o != order) {
+      index = index * 2 + 1;
+      setBit(arena, index);
+      FreelistNode *right = rightChildOfFreelistNode(node, o);
+      ++o;
+      pushFreelist(arena, o, right);
+    }
+    return arena.buffer + ptrOffset;
+  }
+
+  void deallocateToFreelist(Arena &arena, void *ptr, const int order) {
+    std::size_t index = ptrToIndex(arena, ptr, order);
+    int o = order;
+    while (index != 0) {
+      resetBit(arena, index);
+      const std::size_t buddy = buddyOfIndex(index);
+      if (testBit(arena, buddy)) {
+        break;
+      }
+      // NOTE: Coalesce buddies
+      eraseNodeFromFreelist(arena, &getFreelistNode(arena, buddy, o), o);
+      index = parentOfIndex(index);
+      --o;
+    }
+    if (index == 0) {
+      resetBit(arena, 0);
+    }
+    pushFreelist(arena, o, &getFreelistNode(arena, index, o));
+  }
+
+  [[no_unique_address]] UpstreamAllocator m_upstream;
+  std::size_t m_logCapacity;
+  std::size_t m_logBlockCount;
+  Arena *m_arenas;
+  std::size_t m_arenaCount;
+  std::size_t m_arenaCapacity;
+  std::size_t m_current;
+};
+
+static_assert(OwningAllocator<DynamicBuddyResource<8>>);
+static_assert(OverAllocator<DynamicBuddyResource<8>>);
+
+} // namespace strobe
@@ -1,14 +1,28 @@
 #pragma once
 
 #include "memory/AllocatorTraits.hpp"
+#include "memory/PageAllocator.hpp"
+#include "memory/align.hpp"
 #include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <utility>
 namespace strobe {
 
-template <std::size_t BlockSize, std::size_t Alignment,
-          Allocator UpstreamAllocator>
+/// Fixed size pool resource. Blocks are handed out from a intrusive freelist,
+/// if the freelist is empty the next block is carved from the current slab by
+/// bumping a cursor, only if the slab is exhausted a new slab (twice the size
+/// of the previous one) is requested from the upstream allocator.
+/// NOTE: Chunks are never touched before they are handed out for the first
+/// time, therefor with the PageAllocator as upstream, pages of a slab are only
+/// faulted in once they are actually used.
+template <std::size_t BlockSize, std::size_t Alignment = alignof(std::max_align_t),
+          Allocator UpstreamAllocator = PageAllocator>
 class FreelistResource {
+  static_assert(std::has_single_bit(Alignment));
 
   struct FreelistNode {
     FreelistNode *next;
@@ -21,75 +35,251 @@ class FreelistResource {
 
   static constexpr std::size_t ChunkSize = sizeof(Chunk);
 
+  // Every slab starts with a header, which chains it to the previously
+  // allocated slab. Chunks follow directly after the (aligned) header.
+  // Slabs, whose uncarved rest [spareBegin, end of slab) was parked by
+  // absorb, are additionally chained through nextSpare.
+  struct SlabHeader {
+    SlabHeader *next;
+    std::size_t chunkCount;
+    SlabHeader *nextSpare;
+    Chunk *spareBegin;
+  };
+
+  static constexpr std::size_t SlabAlignment =
+      std::max(alignof(Chunk), alignof(SlabHeader));
+  static constexpr std::size_t SlabHeaderSize =
+      align_up(sizeof(SlabHeader), alignof(Chunk));
+
 public:
-  explicit FreelistResource(UpstreamAllocator upstream, std::size_t blockCount)
-      : m_upstream(std::move(upstream)), m_chunkCount(blockCount),
-        m_chunks(UpstreamTraits::allocate(m_upstream, m_chunkCount * ChunkSize,
-                                          Alignment)) {}
-
-  ~FreelistResource() {
-    if (m_chunks != nullptr) {
-      UpstreamAllocator::deallocate(m_upstream, m_chunks,
-                                    m_chunkCount * ChunkSize, Alignment);
-      m_chunks = nullptr;
-    }
+  // Chunk count of the first slab, chosen such that the first slab roughly
+  // fills a single page.
+  static constexpr std::size_t DefaultChunkCount =
+      std::max<std::size_t>(1, (4096 - SlabHeaderSize) / ChunkSize);
 
-    // Setup freelist
-    FreelistNode *prev = nullptr;
-    for (std::int64_t i = m_chunkCount - 1; i >= 0; --i) {
-      m_chunks[i].free.next = prev;
-      prev = &m_chunks[i].free;
-    }
-    m_freelist = prev;
-  }
+  explicit FreelistResource(UpstreamAllocator upstream = {},
+                            std::size_t chunkCount = DefaultChunkCount)
+      : m_upstream(std::move(upstream)),
+        m_initialChunkCount(std::max<std::size_t>(chunkCount, 1)),
+        m_nextChunkCount(m_initialChunkCount),
+        m_slabs(nullptr), m_spare(nullptr), m_cursor(nullptr), m_end(nullptr),
+        m_freelist(nullptr), m_freelistTail(nullptr) {}
+
+  ~FreelistResource() { release(); }
 
   FreelistResource(const FreelistResource &) = delete;
   FreelistResource &operator=(const FreelistResource &) = delete;
 
   FreelistResource(FreelistResource &&o)
-      : m_upstream(std::move(o.m_upstream)), m_chunkCount(o.m_chunkCount),
-        m_chunks(std::exchange(o.m_chunks, nullptr)) {}
+      : m_upstream(std::move(o.m_upstream)),
+        m_initialChunkCount(o.m_initialChunkCount),
+        m_nextChunkCount(o.m_nextChunkCount),
+        m_slabs(std::exchange(o.m_slabs, nullptr)),
+        m_spare(std::exchange(o.m_spare, nullptr)),
+        m_cursor(std::exchange(o.m_cursor, nullptr)),
+        m_end(std::exchange(o.m_end, nullptr)),
+        m_freelist(std::exchange(o.m_freelist, nullptr)),
+        m_freelistTail(std::exchange(o.m_freelistTail, nullptr)) {}
 
   FreelistResource &operator=(FreelistResource &&o) {
     if (this == &o) {
       return *this;
     }
-    if (m_chunks != nullptr) {
-      UpstreamAllocator::deallocate(m_upstream, m_chunks,
-                                    m_chunkCount * ChunkSize, Alignment);
-    }
+    release();
     m_upstream = std::move(o.m_upstream);
-    m_chunkCount = o.m_chunkCount;
-    m_chunks = std::exchange(o.m_chunks, nullptr);
+    m_initialChunkCount = o.m_initialChunkCount;
+    m_nextChunkCount = o.m_nextChunkCount;
+    m_slabs = std::exchange(o.m_slabs, nullptr);
+    m_spare = std::exchange(o.m_spare, nullptr);
+    m_cursor = std::exchange(o.m_cursor, nullptr);
+    m_end = std::exchange(o.m_end, nullptr);
+    m_freelist = std::exchange(o.m_freelist, nullptr);
+    m_freelistTail = std::exchange(o.m_freelistTail, nullptr);
     return *this;
   }
 
   void *allocate(std::size_t size, std::size_t align) {
     assert(size <= BlockSize);
-    assert(align % Alignment == 0);
+    assert(align <= Alignment);
 
-    // TODO
-    return nullptr;
+    FreelistNode *node = m_freelist;
+    if (node != nullptr) {
+      m_freelist = node->next;
+      return node;
+    }
+    if (m_cursor != m_end) {
+      return m_cursor++;
+    }
+    if (m_spare != nullptr) {
+      return allocateFromSpareSlab();
+    }
+    return allocateFromNewSlab();
   }
 
   void deallocate(void *ptr, std::size_t size, std::size_t align) {
     assert(size <= BlockSize);
-    assert(align % Alignment == 0);
+    assert(align <= Alignment);
+    assert(owns(ptr));
 
-    // TODO
+    FreelistNode *node = static_cast<FreelistNode *>(ptr);
+    // The tail is only meaningful while the freelist is not empty.
+    if (m_freelist == nullptr) {
+      m_freelistTail = node;
+    }
+    node->next = m_freelist;
+    m_freelist = node;
   }
 
-  bool owns(void *ptr) {
-    // TODO!
+  // NOTE: Linear in the amount of slabs, which only grows logarithmically
+  // with the amount of allocated blocks.
+  bool owns(const void *ptr) const {
+    const auto *raw = static_cast<const std::byte *>(ptr);
+    for (SlabHeader *slab = m_slabs; slab != nullptr; slab = slab->next) {
+      const std::byte *begin = reinterpret_cast<std::byte *>(chunksOf(slab));
+      if (raw >= begin && raw < begin + slab->chunkCount * ChunkSize) {
+        return true;
+      }
+    }
     return false;
   }
 
+  /// Takes ownership of all slabs of o, such that blocks allocated from o can
+  /// be deallocated through this resource. The free blocks of o are spliced
+  /// onto the freelist, of the two uncarved slab rests the smaller one is
+  /// parked until the other is used up. Linear in the amount of slabs of o,
+  /// which only grows logarithmically with the blocks allocated from o.
+  /// The slabs of o are later released through the upstream allocator of
+  /// this resource, therefore both upstream allocators must compare equal.
+  void absorb(FreelistResource &&o) {
+    assert(this != &o);
+    assert(alloc_equals(m_upstream, o.m_upstream) &&
+           "absorbed slabs are released through this upstream allocator");
+    if (o.m_slabs == nullptr) {
+      return;
+    }
+    SlabHeader *tail = o.m_slabs;
+    while (tail->next != nullptr) {
+      tail = tail->next;
+    }
+    tail->next = m_slabs;
+    m_slabs = std::exchange(o.m_slabs, nullptr);
+
+    if (o.m_freelist != nullptr) {
+      if (m_freelist == nullptr) {
+        m_freelistTail = o.m_freelistTail;
+      }
+      o.m_freelistTail->next = m_freelist;
+      m_freelist = o.m_freelist;
+    }
+
+    if (o.m_spare != nullptr) {
+      SlabHeader *spareTail = o.m_spare;
+      while (spareTail->nextSpare != nullptr) {
+        spareTail = spareTail->nextSpare;
+      }
+      spareTail->nextSpare = m_spare;
+      m_spare = o.m_spare;
+    }
+
+    Chunk *cursor = o.m_cursor;
+    Chunk *end = o.m_end;
+    if (end - cursor > m_end - m_cursor) {
+      std::swap(cursor, m_cursor);
+      std::swap(end, m_end);
+    }
+    if (cursor != end) {
+      park(cursor);
+    }
+
+    m_nextChunkCount = std::max(m_nextChunkCount, o.m_nextChunkCount);
+    o.m_spare = nullptr;
+    o.m_cursor = nullptr;
+    o.m_end = nullptr;
+    o.m_freelist = nullptr;
+    o.m_freelistTail = nullptr;
+    o.m_nextChunkCount = o.m_initialChunkCount;
+  }
+
+  /// Returns all slabs to the upstream allocator. Invalidates all blocks,
+  /// which were allocated from this resource. Slab growth restarts at the
+  /// initial chunk count.
+  void release() {
+    SlabHeader *slab = m_slabs;
+    while (slab != nullptr) {
+      SlabHeader *next = slab->next;
+      UpstreamTraits::deallocate(m_upstream, slab, slabByteSize(slab->chunkCount),
+                                 SlabAlignment);
+      slab = next;
+    }
+    m_slabs = nullptr;
+    m_spare = nullptr;
+    m_cursor = nullptr;
+    m_end = nullptr;
+    m_freelist = nullptr;
+    m_freelistTail = nullptr;
+    m_nextChunkCount = m_initialChunkCount;
+  }
+
 private:
+  static std::size_t slabByteSize(std::size_t chunkCount) {
+    return SlabHeaderSize + chunkCount * ChunkSize;
+  }
+
+  static Chunk *chunksOf(SlabHeader *slab) {
+    return reinterpret_cast<Chunk *>(reinterpret_cast<std::byte *>(slab) +
+                                      SlabHeaderSize);
+  }
+
+  void *allocateFromNewSlab() {
+    const std::size_t chunkCount = m_nextChunkCount;
+    void *raw = UpstreamTraits::allocate(m_upstream, slabByteSize(chunkCount),
+                                         SlabAlignment);
+    if (raw == nullptr) {
+      return nullptr;
+    }
+    SlabHeader *slab =
+        new (raw) SlabHeader{m_slabs, chunkCount, nullptr, nullptr};
+    m_slabs = slab;
+    m_nextChunkCount = chunkCount * 2;
+
+    Chunk *chunks = chunksOf(slab);
+    m_cursor = chunks + 1;
+    m_end = chunks + chunkCount;
+    return chunks;
+  }
+
+  void *allocateFromSpareSlab() {
+    SlabHeader *slab = m_spare;
+    m_spare = slab->nextSpare;
+    m_cursor = slab->spareBegin + 1;
+    m_end = chunksOf(slab) + slab->chunkCount;
+    return slab->spareBegin;
+  }
+
+  // Parks the uncarved rest of a slab, which starts at cursor.
+  void park(Chunk *cursor) {
+    SlabHeader *slab = m_slabs;
+    while (cursor < chunksOf(slab) ||
+           cursor >= chunksOf(slab) + slab->chunkCount) {
+      slab = slab->next;
+    }
+    slab->spareBegin = cursor;
+    slab->nextSpare = m_spare;
+    m_spare = slab;
+  }
+
   using UpstreamTraits = AllocatorTraits<UpstreamAllocator>;
   [[no_unique_address]] UpstreamAllocator m_upstream;
-  std::size_t m_chunkCount;
-  Chunk *m_chunks;
-  Chunk *m_freelist;
+  std::size_t m_initialChunkCount;
+  std::size_t m_nextChunkCount;
+  SlabHeader *m_slabs;
+  SlabHeader *m_spare;
+  Chunk *m_cursor;
+  Chunk *m_end;
+  FreelistNode *m_freelist;
+  FreelistNode *m_freelistTail;
 };
 
+static_assert(OwningAllocator<FreelistResource<8, 8>>);
+
 } // namespace strobe
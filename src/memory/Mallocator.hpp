@@ -1,14 +1,76 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "memory/AllocatorTraits.hpp"
+#include "memory/align.hpp"
 
 namespace strobe {
 
 class Mallocator {
  public:
-   static constexpr bool is_always_equals = true;
+   static constexpr bool is_always_equal = true;
+  // malloc only guarantees alignof(std::max_align_t), larger alignments
+  // are served by aligned_alloc.
   void* allocate(std::size_t size, std::size_t align) {
-    return std::malloc(size);  // You could use aligned_alloc if necessary
+    if (align <= alignof(std::max_align_t)) {
+      return std::malloc(size);
+    }
+    return std::aligned_alloc(align, align_up(size, align));
+  }
+
+  // malloc rounds every request up to its internal size classes. With glibc
+  // the slack is reported by malloc_usable_size, but it may only be used
+  // after the block was grown to it with realloc, which never moves a block
+  // within its usable size. realloc does not preserve larger alignments,
+  // those only report size.
+  std::pair<void*, std::size_t> allocate_at_least(std::size_t size,
+                                                  std::size_t align) {
+    void* ptr = allocate(size, align);
+    if (ptr == nullptr) {
+      return {nullptr, 0};
+    }
+#if defined(__GLIBC__)
+    if (align <= alignof(std::max_align_t)) {
+      const std::size_t usable = malloc_usable_size(ptr);
+      if (usable > size) {
+        void* grown = std::realloc(ptr, usable);
+        if (grown != nullptr) {
+          return {grown, usable};
+        }
+      }
+    }
+#endif
+    return {ptr, size};
+  }
+
+  // NOTE: realloc does not preserve alignments larger than
+  // alignof(std::max_align_t), therefore those are always moved.
+  // newSize must not be 0, realloc would free the allocation.
+  void* reallocate(void* ptr, std::size_t oldSize, std::size_t newSize,
+                   std::size_t align) {
+    assert(newSize != 0 && "reallocate to 0 bytes, use deallocate");
+    if (align <= alignof(std::max_align_t)) {
+      return std::realloc(ptr, newSize);
+    }
+    void* newPtr = allocate(newSize, align);
+    if (newPtr == nullptr) {
+      return nullptr;
+    }
+    if (ptr != nullptr) {
+      std::memcpy(newPtr, ptr, std::min(oldSize, newSize));
+      std::free(ptr);
+    }
+    return newPtr;
   }
 
   void deallocate(void* ptr, std::size_t size, std::size_t) {
@@ -19,5 +81,7 @@ class Mallocator {
     std::free(ptr);
   }
 };
+static_assert(ReAllocator<Mallocator>);
+static_assert(OverAllocator<Mallocator>);
 
 }  // namespace strobe
@@ -6,7 +6,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstring>
 
 #include "memory/align.hpp"
 #include "memory/pages.hpp"
@@ -45,6 +47,36 @@ void* PageAllocator::allocate(std::size_t size, std::size_t alignment) {
   return raw;
 }
 
+std::pair<void*, std::size_t> PageAllocator::allocate_at_least(
+    std::size_t size, std::size_t alignment) {
+  void* ptr = allocate(size, alignment);
+  if (ptr == nullptr) return {nullptr, 0};
+  return {ptr, align_up(size, page_size())};
+}
+
+void* PageAllocator::reallocate(void* ptr, std::size_t oldSize,
+                                std::size_t newSize, std::size_t alignment) {
+  assert(newSize != 0 && "reallocate to 0 bytes, use deallocate");
+  if (ptr == nullptr) return allocate(newSize, alignment);
+  const std::size_t page = page_size();
+  const std::size_t oldMapped = align_up(oldSize, page);
+  const std::size_t newMapped = align_up(newSize, page);
+  if (oldMapped == newMapped) return ptr;
+
+  if (USE_GUARD_PAGES) {
+    // The trailing guard page would have to be moved as well.
+    void* newPtr = allocate(newSize, alignment);
+    if (newPtr == nullptr) return nullptr;
+    std::memcpy(newPtr, ptr, std::min(oldMapped, newMapped));
+    deallocate(ptr, oldSize, alignment);
+    return newPtr;
+  }
+
+  void* raw = mremap(ptr, oldMapped, newMapped, MREMAP_MAYMOVE);
+  if (raw == MAP_FAILED) return nullptr;
+  return raw;
+}
+
 void PageAllocator::deallocate(void* ptr, std::size_t size,
                                std::size_t alignment) {
   if (!ptr) return;
@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <utility>
 
 #include "memory/AllocatorTraits.hpp"
 
@@ -13,8 +14,20 @@ class PageAllocator {
  public:
   [[nodiscard]] void* allocate(std::size_t size, std::size_t align);
 
+  // The mapping is always a whole number of pages, all of them are usable.
+  [[nodiscard]] std::pair<void*, std::size_t> allocate_at_least(
+      std::size_t size, std::size_t align);
+
+  // Grows or shrinks the mapping with mremap, the kernel moves the pages
+  // instead of copying them if the mapping can't be extended in place.
+  // newSize must not be 0.
+  [[nodiscard]] void* reallocate(void* ptr, std::size_t oldSize,
+                                 std::size_t newSize, std::size_t align);
+
   void deallocate(void* ptr, std::size_t size, std::size_t);
 };
 static_assert(Allocator<PageAllocator>);
+static_assert(ReAllocator<PageAllocator>);
+static_assert(OverAllocator<PageAllocator>);
 
 }  // namespace strobe
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+namespace strobe {
+
+/// Assumed size of a cache line, used to pad data which is written by
+/// different threads to avoid false sharing.
+/// NOTE: std::hardware_destructive_interference_size is not used on purpose,
+/// because it is not ABI stable (and gcc warns about it).
+inline constexpr std::size_t cache_line_size = 64;
+
+} // namespace strobe
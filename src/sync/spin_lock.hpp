@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+namespace strobe {
+
+/// Test-and-test-and-set spin lock. Intended for very short critical
+/// sections, which are (almost) never contended.
+/// Satisfies the Lockable named requirement, so it can be used with
+/// std::lock_guard and std::unique_lock.
+class SpinLock {
+public:
+  bool try_lock() noexcept {
+    return !m_locked.load(std::memory_order_relaxed) &&
+           !m_locked.exchange(true, std::memory_order_acquire);
+  }
+
+  void lock() noexcept {
+    while (!try_lock()) {
+      while (m_locked.load(std::memory_order_relaxed)) {
+        pause();
+      }
+    }
+  }
+
+  void unlock() noexcept { m_locked.store(false, std::memory_order_release); }
+
+private:
+  static void pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+  std::atomic<bool> m_locked{false};
+};
+
+} // namespace strobe
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+namespace strobe {
+
+/// Small dense id of the calling thread. Ids are handed out in the order in
+/// which threads first call this function and are never reused.
+/// Used to pick per thread state (e.g. slot % SlotCount) without any
+/// registration of threads.
+inline std::size_t this_thread_slot() noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t slot =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+/// Small dense id of the calling thread, which is unique among all running
+/// threads. Ids of exited threads are reused, the smallest free id first,
+/// i.e. the ids stay below the maximum number of threads that ever ran
+/// concurrently. Used for per thread state, which must have a single writer.
+/// Everything a thread wrote happens before a later thread gets its id.
+inline std::size_t this_thread_live_slot() {
+  struct Registry {
+    std::mutex mutex;
+    std::size_t next = 0;
+    std::priority_queue<std::size_t, std::vector<std::size_t>,
+                        std::greater<std::size_t>>
+        free;
+  };
+  // Constructed before and therefore destroyed after any Holder.
+  static Registry registry;
+  struct Holder {
+    Holder() {
+      std::lock_guard lock{registry.mutex};
+      if (registry.free.empty()) {
+        slot = registry.next++;
+      } else {
+        slot = registry.free.top();
+        registry.free.pop();
+      }
+    }
+    ~Holder() {
+      std::lock_guard lock{registry.mutex};
+      registry.free.push(slot);
+    }
+    std::size_t slot;
+  };
+  thread_local const Holder holder;
+  return holder.slot;
+}
+
+} // namespace strobe
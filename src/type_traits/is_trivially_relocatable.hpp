@@ -0,0 +1,92 @@
+#pragma once
+
+#include "type_traits/trivially_destructible_after_move.hpp"
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+namespace strobe {
+
+/// Is std::true_type iff. a instance of T can be relocated, i.e. move
+/// constructed into new storage and the source destructed, by copying its
+/// bytes with memcpy and not calling the destructor of the source.
+/// This holds for all trivially copyable types, but also for most types,
+/// which own resources through pointers (e.g. std::unique_ptr), as long as
+/// they don't store pointers into themselves.
+/// Opt-in by specializing this trait for your own types.
+/// NOTE: std::string is NOT trivially relocatable with libstdc++, because
+/// the small string optimization stores a pointer to the inline buffer.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>>
+    : is_trivially_relocatable<D> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+template <typename A, typename B>
+struct is_trivially_relocatable<std::pair<A, B>>
+    : std::bool_constant<is_trivially_relocatable_v<A> &&
+                         is_trivially_relocatable_v<B>> {};
+
+template <typename... Ts>
+struct is_trivially_relocatable<std::tuple<Ts...>>
+    : std::bool_constant<(is_trivially_relocatable_v<Ts> && ...)> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::optional<T>>
+    : is_trivially_relocatable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+// The release builds of all major standard libraries implement std::vector
+// as three pointers. The debug containers (_GLIBCXX_DEBUG, MSVC iterator
+// debugging) link their iterators back to the container, which memcpy would
+// leave pointing at the old address.
+#if !defined(_GLIBCXX_DEBUG) &&                                                \
+    (!defined(_ITERATOR_DEBUG_LEVEL) || _ITERATOR_DEBUG_LEVEL == 0)
+template <typename T, typename A>
+struct is_trivially_relocatable<std::vector<T, A>>
+    : is_trivially_relocatable<A> {};
+#endif
+
+/// Relocates the object at src into the uninitialized storage at dst, the
+/// lifetime of *src ends.
+template <typename T> inline void relocate_at(T *src, T *dst) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                sizeof(T));
+  } else {
+    std::construct_at(dst, std::move(*src));
+    std::destroy_at(src);
+  }
+}
+
+/// Relocates n objects from src into the uninitialized storage at dst, the
+/// ranges must not overlap.
+template <typename T> inline void relocate_n(T *src, std::size_t n, T *dst) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                n * sizeof(T));
+  } else {
+    std::uninitialized_move_n(src, n, dst);
+    if constexpr (!is_trivially_destructible_after_move_v<T>) {
+      std::destroy_n(src, n);
+    }
+  }
+}
+
+} // namespace strobe
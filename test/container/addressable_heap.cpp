@@ -0,0 +1,211 @@
+#include "container/fibonaci_heap.hpp"
+#include "container/pairing_heap.hpp"
+#include "container/rank_pairing_heap.hpp"
+#include "heap_test.hpp"
+#include "memory/Mallocator.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+// The node based heaps with handles, decrease_key, erase and meld.
+namespace {
+
+struct PairingHeapFamily {
+  template <typename T, typename Compare = std::less<T>>
+  using heap = strobe::PairingHeap<T, Compare>;
+  template <typename T>
+  using mallocator_heap =
+      strobe::PairingHeap<T, std::less<T>, strobe::Mallocator>;
+};
+
+struct RankPairingHeapFamily {
+  template <typename T, typename Compare = std::less<T>>
+  using heap = strobe::RankPairingHeap<T, Compare>;
+  template <typename T>
+  using mallocator_heap =
+      strobe::RankPairingHeap<T, std::less<T>, strobe::Mallocator>;
+};
+
+struct FibonaciHeapFamily {
+  template <typename T, typename Compare = std::less<T>>
+  using heap = strobe::FibonaciHeap<T, Compare>;
+  template <typename T>
+  using mallocator_heap =
+      strobe::FibonaciHeap<T, std::less<T>, strobe::Mallocator>;
+};
+
+} // namespace
+
+template <typename Family>
+class container_addressable_heap : public testing::Test {};
+
+using AddressableHeaps =
+    testing::Types<PairingHeapFamily, RankPairingHeapFamily,
+                   FibonaciHeapFamily>;
+TYPED_TEST_SUITE(container_addressable_heap, AddressableHeaps);
+
+TYPED_TEST(container_addressable_heap, basic_push_pop_order) {
+  using Heap = typename TypeParam::template heap<int>;
+  Heap q;
+  EXPECT_TRUE(q.empty());
+  q.push(3);
+  q.push(1);
+  q.push(2);
+  EXPECT_EQ(q.top(), 1);
+  q.pop();
+  EXPECT_EQ(q.top(), 2);
+  q.pop();
+  EXPECT_EQ(q.top(), 3);
+  q.pop();
+  EXPECT_TRUE(q.empty());
+}
+
+TYPED_TEST(container_addressable_heap, decrease_key_and_erase) {
+  using Heap = typename TypeParam::template heap<int>;
+  Heap q;
+  std::vector<typename Heap::handle> h;
+  for (int i = 0; i < 10; ++i) {
+    h.push_back(q.push(10 + i));
+  }
+  q.decrease_key(h[7], 1);
+  EXPECT_EQ(q.top(), 1);
+  q.erase(h[7]);
+  EXPECT_EQ(q.top(), 10);
+  q.erase(h[0]);
+  q.erase(h[5]);
+  std::vector<int> out;
+  while (!q.empty()) {
+    out.push_back(q.top());
+    q.pop();
+  }
+  EXPECT_EQ(out, (std::vector<int>{11, 12, 13, 14, 16, 18, 19}));
+}
+
+TYPED_TEST(container_addressable_heap, meld) {
+  using Heap = typename TypeParam::template heap<int>;
+  Heap a;
+  Heap b;
+  std::vector<typename Heap::handle> hb;
+  for (int i = 0; i < 100; ++i) {
+    a.push(2 * i + 100);
+    hb.push_back(b.push(2 * i + 101));
+  }
+  a.pop(); // Linked trees in a.
+  a.meld(std::move(b));
+  EXPECT_TRUE(b.empty());
+  // Handles of b stay valid.
+  a.decrease_key(hb[50], 0);
+  EXPECT_EQ(a.top(), 0);
+  a.erase(hb[50]);
+  int expected = 101;
+  while (!a.empty()) {
+    if (expected == 201) {
+      ++expected;
+    }
+    ASSERT_EQ(a.top(), expected++);
+    a.pop();
+  }
+  // b is still usable.
+  b.push(1);
+  EXPECT_EQ(b.top(), 1);
+}
+
+template <typename Heap> static void fuzzAgainstMultiset(unsigned int seed) {
+  Heap q;
+  std::multiset<std::pair<int, int>> ref;
+  std::vector<typename Heap::handle> handles;
+  std::vector<int> keys;
+  std::vector<bool> alive;
+  std::mt19937 rng(seed);
+  for (int step = 0; step < 20000; ++step) {
+    const unsigned int op = rng() % 8;
+    if (ref.empty() || op < 3) {
+      const int id = static_cast<int>(handles.size());
+      keys.push_back(static_cast<int>(rng() % 100000));
+      alive.push_back(true);
+      handles.push_back(q.push({keys[id], id}));
+      ref.insert({keys[id], id});
+    } else if (op < 6) {
+      const int id = static_cast<int>(rng() % handles.size());
+      if (!alive[id]) {
+        continue;
+      }
+      ref.erase(ref.find({keys[id], id}));
+      keys[id] -= static_cast<int>(rng() % 1000);
+      ref.insert({keys[id], id});
+      q.decrease_key(handles[id], {keys[id], id});
+    } else if (op < 7) {
+      const int id = static_cast<int>(rng() % handles.size());
+      if (!alive[id]) {
+        continue;
+      }
+      alive[id] = false;
+      ref.erase(ref.find({keys[id], id}));
+      q.erase(handles[id]);
+    } else {
+      ASSERT_EQ(q.top(), *ref.begin());
+      alive[q.top().second] = false;
+      ref.erase(ref.begin());
+      q.pop();
+    }
+    ASSERT_EQ(q.empty(), ref.empty());
+    if (!ref.empty()) {
+      ASSERT_EQ(q.top(), *ref.begin());
+    }
+  }
+  while (!ref.empty()) {
+    ASSERT_EQ(q.top(), *ref.begin());
+    ref.erase(ref.begin());
+    q.pop();
+  }
+  EXPECT_TRUE(q.empty());
+}
+
+TYPED_TEST(container_addressable_heap, fuzz_against_multiset) {
+  for (unsigned int seed = 0; seed < 4; ++seed) {
+    fuzzAgainstMultiset<
+        typename TypeParam::template heap<std::pair<int, int>>>(seed);
+  }
+  fuzzAgainstMultiset<
+      typename TypeParam::template mallocator_heap<std::pair<int, int>>>(7);
+}
+
+TYPED_TEST(container_addressable_heap, no_leaks) {
+  using Heap = typename TypeParam::template heap<Tracked>;
+  {
+    Heap q;
+    std::vector<typename Heap::handle> h;
+    for (int i = 0; i < 1000; ++i) {
+      h.push_back(q.push(Tracked(i * 7919 % 1000)));
+    }
+    q.pop();
+    q.erase(h[500]);
+    q.decrease_key(h[999], Tracked(-1));
+    q.pop();
+    EXPECT_EQ(Tracked::alive.load(), 997);
+    q.clear();
+    EXPECT_EQ(Tracked::alive.load(), 0);
+    for (int i = 0; i < 100; ++i) {
+      q.push(Tracked(i));
+    }
+    q.pop();
+  }
+  EXPECT_EQ(Tracked::alive.load(), 0);
+}
+
+TYPED_TEST(container_addressable_heap, strings_with_custom_comparator) {
+  using Heap =
+      typename TypeParam::template heap<std::string, std::greater<std::string>>;
+  Heap q;
+  for (const char *s : {"b", "d", "a", "c"}) {
+    q.push(s);
+  }
+  std::string out;
+  while (!q.empty()) {
+    out += q.top();
+    q.pop();
+  }
+  EXPECT_EQ(out, "dcba");
+}
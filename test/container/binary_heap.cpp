@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "container/binary_heap.hpp"
+#include "heap_test.hpp"
+#include <memory>
+#include <queue>
+#include <random>
 
 
 TEST(container_binary_heap, simple) {
@@ -20,3 +24,81 @@ TEST(container_binary_heap, simple) {
   heap.pop();
   EXPECT_TRUE(heap.empty());
 }
+
+TEST(container_binary_heap, random_against_priority_queue) {
+  strobe::BinaryHeap<int> heap;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  for (int i = 0; i < 10000; ++i) {
+    if (reference.empty() || prng() % 3 != 0) {
+      const int v = dist(prng);
+      heap.push(v);
+      reference.push(v);
+    } else {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(container_binary_heap, owning_elements) {
+  struct Less {
+    bool operator()(const std::unique_ptr<int> &a,
+                    const std::unique_ptr<int> &b) const {
+      return *a < *b;
+    }
+  };
+  strobe::BinaryHeap<std::unique_ptr<int>, strobe::Vector<std::unique_ptr<int>>,
+                     Less>
+      heap;
+  for (int v : {5, 3, 8, 1, 9, 2, 7}) {
+    heap.push(std::make_unique<int>(v));
+  }
+  for (int v : {1, 2, 3, 5, 7, 8, 9}) {
+    ASSERT_EQ(*heap.top(), v);
+    heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(container_binary_heap, push_range) {
+  pushRangeAgainstPriorityQueue<strobe::BinaryHeap<int>>();
+}
+
+TEST(container_binary_heap, meld) {
+  for (std::size_t lhs : {0, 1, 10, 1000}) {
+    for (std::size_t rhs : {0, 1, 10, 1000}) {
+      std::mt19937 prng(lhs * 31 + rhs);
+      strobe::BinaryHeap<int> a;
+      strobe::BinaryHeap<int> b;
+      std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+      for (std::size_t i = 0; i < lhs; ++i) {
+        const int v = static_cast<int>(prng() % 1000);
+        a.push(v);
+        reference.push(v);
+      }
+      for (std::size_t i = 0; i < rhs; ++i) {
+        const int v = static_cast<int>(prng() % 1000);
+        b.push(v);
+        reference.push(v);
+      }
+      a.meld(std::move(b));
+      EXPECT_TRUE(b.empty());
+      ASSERT_EQ(a.size(), reference.size());
+      while (!reference.empty()) {
+        ASSERT_EQ(a.top(), reference.top());
+        a.pop();
+        reference.pop();
+      }
+    }
+  }
+}
@@ -0,0 +1,71 @@
+#include "container/blocked_fenwick_tree.hpp"
+#include "container/fenwick_tree.hpp"
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+TEST(container_blocked_fenwick_tree, simple) {
+  BlockedFenwickTree<int> tree(10);
+  for (int i = 0; i < 10; ++i)
+    tree.update(i, i + 1); // [1,2,...,10]
+
+  EXPECT_EQ(tree.prefix_query(9), 55);
+  EXPECT_EQ(tree.range_query(0, 9), 55);
+  EXPECT_EQ(tree.range_query(3, 6), 4 + 5 + 6 + 7);
+  EXPECT_EQ(tree.at(0), 1);
+  EXPECT_EQ(tree.at(9), 10);
+
+  tree.set(4, 100);
+  EXPECT_EQ(tree.at(4), 100);
+  EXPECT_EQ(tree.prefix_query(9), 55 - 5 + 100);
+}
+
+TEST(container_blocked_fenwick_tree, non_finite_delta) {
+  const double inf = std::numeric_limits<double>::infinity();
+  BlockedFenwickTree<double> tree(100);
+  tree.update(5, 1.0);
+  tree.update(6, inf);
+  EXPECT_EQ(tree.prefix_query(0), 0.0);
+  EXPECT_EQ(tree.prefix_query(5), 1.0);
+  EXPECT_EQ(tree.prefix_query(6), inf);
+  EXPECT_EQ(tree.prefix_query(99), inf);
+
+  tree.update(50, std::numeric_limits<double>::quiet_NaN());
+  EXPECT_EQ(tree.prefix_query(5), 1.0);
+  EXPECT_EQ(tree.prefix_query(49), inf);
+  EXPECT_TRUE(std::isnan(tree.prefix_query(50)));
+}
+
+template <std::size_t B> static void randomAgainstFenwickTree(std::size_t n) {
+  BlockedFenwickTree<std::int64_t, std::plus<std::int64_t>,
+                     std::minus<std::int64_t>, B>
+      tree(n);
+  FenwickTree<std::int64_t> reference(n);
+  std::mt19937 prng(n);
+  for (int i = 0; i < 5000; ++i) {
+    const std::size_t index = prng() % n;
+    const std::int64_t delta = static_cast<std::int64_t>(prng() % 201) - 100;
+    tree.update(index, delta);
+    reference.update(index, delta);
+    const std::size_t l = prng() % n;
+    const std::size_t r = l + prng() % (n - l);
+    ASSERT_EQ(tree.prefix_query(r), reference.prefix_query(r))
+        << "n = " << n << ", B = " << B;
+    ASSERT_EQ(tree.range_query(l, r), reference.range_query(l, r));
+  }
+  for (std::size_t r = 0; r < n; ++r) {
+    ASSERT_EQ(tree.prefix_query(r), reference.prefix_query(r));
+  }
+}
+
+TEST(container_blocked_fenwick_tree, random_against_fenwick_tree) {
+  for (std::size_t n : {1, 2, 7, 8, 9, 63, 64, 65, 1000, 4096, 100000}) {
+    randomAgainstFenwickTree<2>(n);
+    randomAgainstFenwickTree<4>(n);
+    randomAgainstFenwickTree<8>(n);
+    randomAgainstFenwickTree<64>(n);
+  }
+}
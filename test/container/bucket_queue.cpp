@@ -1 +1,200 @@
 #include "container/bucket_queue.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Entry {
+  unsigned int dist;
+  unsigned int id;
+};
+
+struct EntryKey {
+  unsigned int operator()(const Entry &e) const { return e.dist; }
+};
+
+} // namespace
+
+TEST(container_bucket_queue, basic_push_pop_order) {
+  strobe::BucketQueue<unsigned int> q(16);
+  EXPECT_TRUE(q.empty());
+
+  q.push(3u);
+  q.push(1u);
+  q.push(2u);
+  q.push(1u);
+  EXPECT_EQ(q.size(), 4);
+
+  std::vector<unsigned int> out;
+  while (!q.empty()) {
+    out.push_back(q.top());
+    q.pop();
+  }
+  EXPECT_EQ(out, (std::vector<unsigned int>{1, 1, 2, 3}));
+}
+
+TEST(container_bucket_queue, ring_wraps_around) {
+  // Window of 8 keys, the keys cycle through the ring multiple times.
+  strobe::BucketQueue<unsigned int> q(8);
+  unsigned int last = 0;
+  q.push(0u);
+  for (unsigned int i = 0; i < 1000; ++i) {
+    const unsigned int k = q.top();
+    EXPECT_GE(k, last);
+    last = k;
+    q.pop();
+    q.push(k + 7);
+    q.push(k + 3);
+    if (q.size() > 16) {
+      q.pop();
+    }
+  }
+}
+
+TEST(container_bucket_queue, sparse_buckets) {
+  // More than one bitmap word, only a few buckets are occupied.
+  strobe::BucketQueue<unsigned int> q(1000);
+  q.push(999u);
+  q.push(500u);
+  q.push(64u);
+  EXPECT_EQ(q.top(), 64u);
+  q.pop();
+  q.push(1063u);
+  EXPECT_EQ(q.top(), 500u);
+  q.pop();
+  EXPECT_EQ(q.top(), 999u);
+  q.pop();
+  EXPECT_EQ(q.top(), 1063u);
+  q.pop();
+  EXPECT_TRUE(q.empty());
+
+  // Pushing into a empty queue moves the window.
+  q.push(5000u);
+  q.push(5999u);
+  EXPECT_EQ(q.top(), 5000u);
+  q.pop();
+  EXPECT_EQ(q.top(), 5999u);
+}
+
+TEST(container_bucket_queue, decrease_key) {
+  strobe::BucketQueue<Entry, EntryKey> q(100);
+  auto a = q.push(Entry{50, 0});
+  auto b = q.push(Entry{60, 1});
+  q.push(Entry{70, 2});
+  EXPECT_EQ(q.top().id, 0u);
+
+  q.decrease_key(b, Entry{10, 1});
+  EXPECT_EQ(q.top().id, 1u);
+  q.decrease_key(a, [](Entry &e) { e.dist = 5; });
+  EXPECT_EQ(q.top().id, 0u);
+  q.pop();
+  EXPECT_EQ(q.top().id, 1u);
+  q.pop();
+  EXPECT_EQ(q.top().id, 2u);
+}
+
+TEST(container_bucket_queue, decrease_key_empties_min_bucket) {
+  strobe::BucketQueue<Entry, EntryKey> q(100);
+  q.push(Entry{0, 0});
+  q.pop();
+  auto a = q.push(Entry{20, 1});
+  q.push(Entry{30, 2});
+  q.push(Entry{25, 3});
+  q.decrease_key(a, Entry{20, 4});
+  EXPECT_EQ(q.top().id, 4u);
+  q.decrease_key(a, Entry{10, 5});
+  EXPECT_EQ(q.top().id, 5u);
+}
+
+TEST(container_bucket_queue, owning_values) {
+  auto shared = std::make_shared<int>(0);
+  struct Value {
+    unsigned int key;
+    std::shared_ptr<int> ptr;
+  };
+  struct ValueKey {
+    unsigned int operator()(const Value &v) const { return v.key; }
+  };
+  {
+    strobe::BucketQueue<Value, ValueKey> q(32);
+    for (unsigned int i = 0; i < 100; ++i) {
+      q.push(Value{i % 32, shared});
+    }
+    EXPECT_EQ(shared.use_count(), 101);
+    for (int i = 0; i < 50; ++i) {
+      q.pop();
+    }
+    EXPECT_EQ(shared.use_count(), 51);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(container_bucket_queue, dijkstra_matches_reference) {
+  constexpr unsigned int n = 2000;
+  constexpr unsigned int maxWeight = 100;
+  std::mt19937 prng(42);
+  std::uniform_int_distribution<unsigned int> vertex(0, n - 1);
+  std::uniform_int_distribution<unsigned int> weight(0, maxWeight);
+
+  struct Edge {
+    unsigned int to;
+    unsigned int w;
+  };
+  std::vector<std::vector<Edge>> graph(n);
+  for (unsigned int v = 0; v < n; ++v) {
+    for (int e = 0; e < 8; ++e) {
+      graph[v].push_back(Edge{vertex(prng), weight(prng)});
+    }
+  }
+
+  constexpr unsigned int inf = std::numeric_limits<unsigned int>::max();
+  std::vector<unsigned int> expected(n, inf);
+  {
+    using P = std::pair<unsigned int, unsigned int>;
+    std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
+    expected[0] = 0;
+    pq.push({0, 0});
+    while (!pq.empty()) {
+      auto [d, v] = pq.top();
+      pq.pop();
+      if (d != expected[v]) {
+        continue;
+      }
+      for (const Edge &e : graph[v]) {
+        if (d + e.w < expected[e.to]) {
+          expected[e.to] = d + e.w;
+          pq.push({d + e.w, e.to});
+        }
+      }
+    }
+  }
+
+  std::vector<unsigned int> dist(n, inf);
+  std::vector<void *> handles(n, nullptr);
+  std::vector<bool> settled(n, false);
+  strobe::BucketQueue<Entry, EntryKey> q(maxWeight + 1);
+  dist[0] = 0;
+  handles[0] = q.push(Entry{0, 0});
+  while (!q.empty()) {
+    const Entry top = q.top();
+    q.pop();
+    settled[top.id] = true;
+    for (const Edge &e : graph[top.id]) {
+      const unsigned int d = top.dist + e.w;
+      if (settled[e.to] || d >= dist[e.to]) {
+        continue;
+      }
+      dist[e.to] = d;
+      if (handles[e.to] == nullptr) {
+        handles[e.to] = q.push(Entry{d, e.to});
+      } else {
+        q.decrease_key(handles[e.to], Entry{d, e.to});
+      }
+    }
+  }
+  EXPECT_EQ(dist, expected);
+}
@@ -1,3 +1,5 @@
+#include "container/cow_vector.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include "my_container.hpp"
 #include <algorithm>
@@ -5,12 +7,14 @@
 #include <print>
 #include <random>
 #include <type_traits>
+#include <utility>
 
 // NOTE: This test is only applicable if the container is constructible from
 // a range and it is copy constructible
-TEST(container_competition, copy_constructible) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
-  if (std::is_copy_constructible_v<Instance>) {
+//
+// Returns true, if copies of Instance compare equal to the original.
+template <typename Instance> static bool copyConstructible() {
+  if constexpr (std::is_copy_constructible_v<Instance>) {
 
     static constexpr std::size_t n = 1000;
     std::vector<float> reference(n);
@@ -23,25 +27,58 @@ TEST(container_competition, copy_constructible) {
     }
 
     Instance container{reference};
-    ASSERT_TRUE(std::ranges::equal(container, reference));
+    EXPECT_TRUE(std::ranges::equal(container, reference));
 
     Instance copy{container};
 
-    ASSERT_TRUE(std::ranges::equal(container, copy));
+    const bool ok = std::ranges::equal(container, reference) &&
+                    std::ranges::equal(container, copy);
+    EXPECT_TRUE(ok);
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container is "
                  "copy constructible (+5 points)\033[0m");
+    return ok;
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is not "
                  "copy constructible (0 points)\033[0m");
+    return false;
   }
 }
 
+TEST(container_competition, copy_constructible) {
+  copyConstructible<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, copy_constructible_small_vector) {
+  EXPECT_TRUE((copyConstructible<
+               strobe::SmallVector<float, 4, strobe::Mallocator>>()));
+}
+
+// Copies of a CowVector share the elements until one of them is written.
+TEST(container_competition, copy_constructible_cow_vector) {
+  using Instance = strobe::CowVector<float, strobe::Mallocator>;
+  EXPECT_TRUE(copyConstructible<Instance>());
+
+  const std::vector<float> reference{1, 2, 3};
+  Instance container{reference};
+  Instance copy{container};
+  EXPECT_EQ(container.use_count(), 2);
+  EXPECT_EQ(std::as_const(container).begin(), std::as_const(copy).begin());
+
+  copy[0] = 42;
+  EXPECT_EQ(container.use_count(), 1);
+  EXPECT_EQ(copy.use_count(), 1);
+  EXPECT_TRUE(std::ranges::equal(container, reference));
+  EXPECT_EQ(std::as_const(copy)[0], 42);
+}
+
 // NOTE: This test is only applicable if the container is constructible from
 // a range and it is copy assignable
-TEST(container_competition, copy_assignable) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
-  if (std::is_copy_assignable_v<Instance>) {
+//
+// Returns true, if Instance compares equal to the original after a copy
+// assignment.
+template <typename Instance> static bool copyAssignable() {
+  if constexpr (std::is_copy_assignable_v<Instance>) {
 
     static constexpr std::size_t n = 1000;
     std::vector<float> reference(n);
@@ -54,17 +91,34 @@ TEST(container_competition, copy_assignable) {
     }
 
     Instance container{reference};
-    ASSERT_TRUE(std::ranges::equal(container, reference));
+    EXPECT_TRUE(std::ranges::equal(container, reference));
 
     Instance copy;
     copy = container;
 
-    ASSERT_TRUE(std::ranges::equal(container, copy));
+    const bool ok = std::ranges::equal(container, reference) &&
+                    std::ranges::equal(container, copy);
+    EXPECT_TRUE(ok);
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container is "
                  "copy assignable (+5 points)\033[0m");
+    return ok;
   } else {
     std::println("\033[1;35m[SKIPPED   ]\033[0m \033[1;33mContainer is not "
                  "copy assignable (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, copy_assignable) {
+  copyAssignable<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, copy_assignable_small_vector) {
+  EXPECT_TRUE(
+      (copyAssignable<strobe::SmallVector<float, 4, strobe::Mallocator>>()));
+}
+
+TEST(container_competition, copy_assignable_cow_vector) {
+  EXPECT_TRUE((copyAssignable<strobe::CowVector<float, strobe::Mallocator>>()));
+}
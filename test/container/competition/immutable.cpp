@@ -1,4 +1,5 @@
 #include "container/container_concepts.hpp"
+#include "container/cow_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include "my_container.hpp"
 #include <gtest/gtest.h>
@@ -6,8 +7,9 @@
 
 // NOTE: This test is only applicable if the container is constructible from
 // a range and it is copy constructible
-TEST(container_competition, immutable) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance is immutable.
+template <typename Instance> static bool immutable() {
   if ((strobe::Container<Instance> && !strobe::StackLikeContainer<Instance> &&
        !strobe::SetLikeContainer<Instance> &&
        !strobe::ContainerSupportsInsertion<Instance> &&
@@ -15,8 +17,18 @@ TEST(container_competition, immutable) {
     std::println(
         "\033[1;33;45m[AWESOME   ]\033[0m\033[1;93;45m 🥳 Your container is "
         "immutable 🥳 (+35 points)\033[0m");
+    return true;
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is not "
                  "immutable (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, immutable) {
+  immutable<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, immutable_cow_vector) {
+  EXPECT_TRUE((immutable<strobe::CowVector<float, strobe::Mallocator>>()));
+}
@@ -1,5 +1,6 @@
 #include "./my_container.hpp"
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include <algorithm>
 #include <gtest/gtest.h>
@@ -10,8 +11,9 @@
 // NOTE: This test is only applicable if the container fullfills
 // ContainerSupportsInsertion. i.e. it defined a function
 // - insert(const_iterator pos, const T& value);
-TEST(container_competition, insert_element) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance supports element insertion.
+template <typename Instance> static bool insertElement() {
   if constexpr (strobe::ContainerSupportsInsertion<Instance>) {
 
     static constexpr std::size_t n = 1000;
@@ -36,21 +38,37 @@ TEST(container_competition, insert_element) {
         container.insert(pos, v);
         reference.insert(reference.begin() + index, v);
       }
-      ASSERT_TRUE(std::ranges::equal(reference, container));
+      if (!std::ranges::equal(reference, container)) {
+        ADD_FAILURE() << "insertion at " << index << " diverged";
+        return false;
+      }
     }
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container "
                  "supports element insertion (+10 points)\033[0m");
+    return true;
   } else {
 
     std::println("\033[1;35m[SKIPPED   ]\033[0m \033[1;33mContainer does not "
                  "support element insertion (0 points)\033[0m");
+    return false;
   }
 }
 
+TEST(container_competition, insert_element) {
+  insertElement<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, insert_element_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(strobe::ContainerSupportsInsertion<Instance>);
+  EXPECT_TRUE(insertElement<Instance>());
+}
+
 // NOTE: Similar to but takes a range as input.
-TEST(container_competition, insert_range) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance supports range insertion.
+template <typename Instance> static bool insertRange() {
   using generic_range = std::list<float>;
   if constexpr (strobe::ContainerSupportsRangeInsertion<Instance, generic_range>) {
 
@@ -84,14 +102,30 @@ TEST(container_competition, insert_range) {
         reference.insert(reference.begin() + index, std::ranges::begin(temp),
                          std::ranges::end(temp));
       }
-      ASSERT_TRUE(std::ranges::equal(reference, container));
+      if (!std::ranges::equal(reference, container)) {
+        ADD_FAILURE() << "range insertion at " << index << " diverged";
+        return false;
+      }
     }
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container "
                  "supports range insertion (+10 points)\033[0m");
+    return true;
   } else {
 
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer does not "
                  "support range insertion (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, insert_range) {
+  insertRange<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, insert_range_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(
+      strobe::ContainerSupportsRangeInsertion<Instance, std::list<float>>);
+  EXPECT_TRUE(insertRange<Instance>());
+}
@@ -1,3 +1,4 @@
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include "my_container.hpp"
 #include <gtest/gtest.h>
@@ -7,9 +8,9 @@
 
 // NOTE: This test is only applicable if the container is constructible from
 // a range and it is move constructible
-TEST(container_competition, move_constructible) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
-
+//
+// Returns true, if Instance keeps its elements when move constructed.
+template <typename Instance> static bool moveConstructible() {
   if constexpr (std::is_move_constructible_v<Instance>) {
     constexpr std::size_t n = 1000;
     std::vector<float> reference(n);
@@ -20,25 +21,38 @@ TEST(container_competition, move_constructible) {
                   [&] { return dist(prng); });
 
     Instance container{reference};
-    ASSERT_TRUE(std::ranges::equal(container, reference));
+    EXPECT_TRUE(std::ranges::equal(container, reference));
 
     Instance moved{std::move(container)};
-    ASSERT_TRUE(std::ranges::equal(moved, reference));
-    ASSERT_TRUE(container.empty() || std::ranges::equal(container, reference));
+    const bool ok =
+        std::ranges::equal(moved, reference) &&
+        (container.empty() || std::ranges::equal(container, reference));
+    EXPECT_TRUE(ok);
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container "
                  "is move-constructible (+5 points)\033[0m");
+    return ok;
   } else {
     std::println("\033[1;35m[SKIPPED   ]\033[0m \033[1;33mContainer is "
                  "not move-constructible (0 points)\033[0m");
+    return false;
   }
 }
 
+TEST(container_competition, move_constructible) {
+  moveConstructible<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, move_constructible_small_vector) {
+  EXPECT_TRUE((moveConstructible<
+               strobe::SmallVector<float, 4, strobe::Mallocator>>()));
+}
+
 // NOTE: This test is only applicable if the container is constructible from
 // a range and it is move assignable
-TEST(container_competition, move_assignable) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
-
+//
+// Returns true, if Instance keeps its elements when move assigned.
+template <typename Instance> static bool moveAssignable() {
   if constexpr (std::is_move_assignable_v<Instance>) {
     constexpr std::size_t n = 1000;
     std::vector<float> reference(n);
@@ -49,18 +63,31 @@ TEST(container_competition, move_assignable) {
                   [&] { return dist(prng); });
 
     Instance container{reference};
-    ASSERT_TRUE(std::ranges::equal(container, reference));
+    EXPECT_TRUE(std::ranges::equal(container, reference));
 
     Instance moved;
     moved = std::move(container);
 
-    ASSERT_TRUE(std::ranges::equal(moved, reference));
-    ASSERT_TRUE(container.empty() || std::ranges::equal(container, reference));
+    const bool ok =
+        std::ranges::equal(moved, reference) &&
+        (container.empty() || std::ranges::equal(container, reference));
+    EXPECT_TRUE(ok);
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container "
                  "is move-assignable (+5 points)\033[0m");
+    return ok;
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is "
                  "not move-assignable (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, move_assignable) {
+  moveAssignable<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, move_assignable_small_vector) {
+  EXPECT_TRUE(
+      (moveAssignable<strobe::SmallVector<float, 4, strobe::Mallocator>>()));
+}
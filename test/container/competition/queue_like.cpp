@@ -1,15 +1,15 @@
 #include "./my_container.hpp"
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
+#include "container/spsc_queue.hpp"
 #include "memory/Mallocator.hpp"
 #include <gtest/gtest.h>
 #include <print>
 #include <queue>
 #include <random>
 
-// NOTE: TODO
-TEST(container_competition, fifo_queue_like) {
-  using Instance = MyContainer<float, strobe::Mallocator>;
-
+// Returns true, if Instance behaves like a fifo queue.
+template <typename Instance> static bool fifoQueueLike() {
   if constexpr (strobe::QueueLikeContainer<Instance>) {
 
     constexpr std::size_t n = 20000;
@@ -47,14 +47,33 @@ TEST(container_competition, fifo_queue_like) {
           "\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is does not "
           "behave like a fifo queue (0 points)\033[0m");
     }
+    return ok;
 
   } else {
     std::println(
         "\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is does not "
         "support a queue like interface (0 points)\033[0m");
+    return false;
   }
 }
 
+// NOTE: TODO
+TEST(container_competition, fifo_queue_like) {
+  fifoQueueLike<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, fifo_queue_like_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(strobe::QueueLikeContainer<Instance>);
+  EXPECT_TRUE(fifoQueueLike<Instance>());
+}
+
+TEST(container_competition, fifo_queue_like_spsc_queue) {
+  using Instance = strobe::SpscQueue<float, strobe::Mallocator>;
+  static_assert(strobe::QueueLikeContainer<Instance>);
+  EXPECT_TRUE(fifoQueueLike<Instance>());
+}
+
 // NOTE: TODO
 TEST(container_competition, priority_queue_like) {
   using Instance = MyContainer<float, strobe::Mallocator>;
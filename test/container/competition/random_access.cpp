@@ -1,5 +1,6 @@
 #include "./my_container.hpp"
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include <gtest/gtest.h>
 #include <print>
@@ -14,9 +15,8 @@
 // a inital size, the values within the container can be undefined after
 // construction!
 //
-TEST(container_competition, random_access) {
-  // container with 10 elements!
-  using Instance = MyContainer<float, strobe::Mallocator>;
+// Returns true, if Instance supports random access.
+template <typename Instance> static bool randomAccess() {
   if constexpr (strobe::RandomAccessContainer<Instance>) {
     constexpr std::size_t n = 1000;
 
@@ -36,13 +36,29 @@ TEST(container_competition, random_access) {
         container[index] = v;
         reference[index] = v;
       } else {
-        ASSERT_EQ(reference[index].value(), container[index]) << " \"index\" is equal to " << index;
+        if (reference[index].value() != container[index]) {
+          ADD_FAILURE() << " \"index\" is equal to " << index;
+          return false;
+        }
         reference[index] = std::nullopt;
       }
     }
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container supports random access (+10 points)\033[0m");
+    return true;
   } else {
 
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is not stack like (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, random_access) {
+  // container with 10 elements!
+  randomAccess<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, random_access_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(strobe::RandomAccessContainer<Instance>);
+  EXPECT_TRUE(randomAccess<Instance>());
+}
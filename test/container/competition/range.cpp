@@ -1,4 +1,5 @@
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include "my_container.hpp"
 #include <gtest/gtest.h>
@@ -13,9 +14,9 @@
 // - std::ranges::bidirectional_range
 // - std::ranges::random_access_range
 // - std::ranges::contiguous_range
-TEST(container_competition, iterable) {
-
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance is a range.
+template <typename Instance> static bool iterable() {
   if (std::ranges::range<Instance>) {
     if (std::ranges::forward_range<Instance>) {
       if (std::ranges::bidirectional_range<Instance>) {
@@ -44,7 +45,19 @@ TEST(container_competition, iterable) {
       std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container is "
                    "a forward range (+3 points)\033[0m");
     }
+    return true;
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mYour container is not a range (0 points)\033[0m");
+    return false;
   }
 }
+
+TEST(container_competition, iterable) {
+  iterable<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, iterable_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(std::ranges::contiguous_range<Instance>);
+  EXPECT_TRUE(iterable<Instance>());
+}
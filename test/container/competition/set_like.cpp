@@ -1,4 +1,5 @@
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include "my_container.hpp"
 #include <gtest/gtest.h>
@@ -13,9 +14,9 @@
 // - empty() -> bool
 //
 // Additionally requires a default constructor!
-TEST(container_competition, set) {
-
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance behaves like a set.
+template <typename Instance> static bool setLike() {
   if constexpr (strobe::SetLikeContainer<Instance>) {
 
     static constexpr std::size_t n = 100;
@@ -36,24 +37,36 @@ TEST(container_competition, set) {
     for (std::size_t i = 0; i < n; ++i) {
       const auto index = indexDist(prng);
       const auto v = values[index];
+      const bool before = container.contains(v);
       if (added[index]) {
-        ASSERT_TRUE(container.contains(v));
         container.remove(v);
-        ASSERT_FALSE(container.contains(v));
       } else {
-        ASSERT_FALSE(container.contains(v));
         container.add(v);
-        ASSERT_TRUE(container.contains(v));
+      }
+      if (before != added[index] || container.contains(v) == added[index]) {
+        ADD_FAILURE() << "contains(" << v << ") is wrong";
+        return false;
       }
       added[index].flip();
     }
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container "
                  "supports set interface (+10 points)\033[0m");
+    return true;
 
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is not set "
                  "like (0 points)\033[0m");
+    return false;
   }
-  ASSERT_EQ(true, true);
+}
+
+TEST(container_competition, set) {
+  setLike<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, set_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(strobe::SetLikeContainer<Instance>);
+  EXPECT_TRUE(setLike<Instance>());
 }
@@ -1,4 +1,5 @@
 #include "container/container_concepts.hpp"
+#include "container/small_vector.hpp"
 #include "memory/Mallocator.hpp"
 #include <print>
 #include "my_container.hpp"
@@ -13,9 +14,9 @@
 // - empty() -> bool
 //
 // Additionally requires a default constructor!
-TEST(container_competition, stack) {
-
-  using Instance = MyContainer<float, strobe::Mallocator>;
+//
+// Returns true, if Instance behaves like a stack.
+template <typename Instance> static bool stackLike() {
   if constexpr (strobe::StackLikeContainer<Instance>) {
     std::random_device rng;
     std::mt19937 prng{rng()};
@@ -24,6 +25,8 @@ TEST(container_competition, stack) {
     std::vector<float> reference;
     Instance container;
 
+    bool ok = true;
+
     static constexpr std::size_t n = 10000;
     for (std::size_t i = 0; i < n; ++i) {
       EXPECT_EQ(container.empty(), reference.empty());
@@ -32,6 +35,7 @@ TEST(container_competition, stack) {
         const auto value = container.top();
         const auto expected = reference.back();
         EXPECT_EQ(value, expected);
+        ok = ok && value == expected;
         container.pop();
         reference.pop_back();
       } else {
@@ -41,9 +45,20 @@ TEST(container_competition, stack) {
     }
 
     std::println("\033[1;34m[SUCCESS   ]\033[0m \033[1;36mYour container supports stack interface (+10 points)\033[0m");
+    return ok;
 
   } else {
     std::println("\033[1;90m[SKIPPED   ]\033[0m \033[1;90mContainer is not stack like (0 points)\033[0m");
+    return false;
   }
-  ASSERT_EQ(true, true);
+}
+
+TEST(container_competition, stack) {
+  stackLike<MyContainer<float, strobe::Mallocator>>();
+}
+
+TEST(container_competition, stack_small_vector) {
+  using Instance = strobe::SmallVector<float, 4, strobe::Mallocator>;
+  static_assert(strobe::StackLikeContainer<Instance>);
+  EXPECT_TRUE(stackLike<Instance>());
 }
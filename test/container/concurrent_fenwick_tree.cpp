@@ -0,0 +1,101 @@
+#include "container/concurrent_fenwick_tree.hpp"
+#include "container/fenwick_tree.hpp"
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+template <typename Tree, typename... Args>
+static void randomAgainstFenwickTree(const Args &...args) {
+  constexpr std::size_t N = 1000;
+  Tree tree(N, args...);
+  FenwickTree<std::int64_t> reference(N);
+  std::mt19937 prng(0);
+  for (int i = 0; i < 10000; ++i) {
+    const std::size_t index = prng() % N;
+    const std::int64_t delta = static_cast<std::int64_t>(prng() % 201) - 100;
+    tree.update(index, delta);
+    reference.update(index, delta);
+    const std::size_t l = prng() % N;
+    const std::size_t r = l + prng() % (N - l);
+    ASSERT_EQ(tree.prefix_query(r), reference.prefix_query(r));
+    ASSERT_EQ(tree.range_query(l, r), reference.range_query(l, r));
+  }
+  EXPECT_EQ(tree.size(), N);
+}
+
+TEST(container_concurrent_fenwick_tree, atomic_random) {
+  randomAgainstFenwickTree<AtomicFenwickTree<std::int64_t>>();
+}
+
+TEST(container_concurrent_fenwick_tree, sharded_random) {
+  randomAgainstFenwickTree<ShardedFenwickTree<std::int64_t>>(4);
+}
+
+TEST(container_concurrent_fenwick_tree, floating_point) {
+  AtomicFenwickTree<double> tree(8);
+  tree.update(3, 0.5);
+  tree.update(7, 1.5);
+  EXPECT_DOUBLE_EQ(tree.prefix_query(7), 2.0);
+  EXPECT_DOUBLE_EQ(tree.at(3), 0.5);
+}
+
+// Threads increment random counters, while a reader checks that prefix sums
+// never decrease, i.e. updates are never observed partially.
+template <typename Tree, typename... Args>
+static void concurrentUpdates(const Args &...args) {
+  constexpr std::size_t N = 4096;
+  constexpr int ThreadCount = 8;
+  constexpr int PerThread = 50000;
+  Tree tree(N, args...);
+
+  std::atomic<bool> done{false};
+  bool monotonic = true;
+  std::thread reader([&] {
+    std::int64_t last = 0;
+    while (!done.load()) {
+      const std::int64_t sum = tree.prefix_query(N - 1);
+      monotonic &= sum >= last;
+      last = sum;
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int t = 0; t < ThreadCount; ++t) {
+    writers.emplace_back([&, t] {
+      std::mt19937 prng(t);
+      for (int i = 0; i < PerThread; ++i) {
+        tree.update(prng() % N, 1);
+      }
+    });
+  }
+  for (auto &thread : writers) {
+    thread.join();
+  }
+  done = true;
+  reader.join();
+  EXPECT_TRUE(monotonic);
+
+  std::vector<std::int64_t> expected(N, 0);
+  for (int t = 0; t < ThreadCount; ++t) {
+    std::mt19937 prng(t);
+    for (int i = 0; i < PerThread; ++i) {
+      ++expected[prng() % N];
+    }
+  }
+  std::int64_t sum = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    sum += expected[i];
+    ASSERT_EQ(tree.prefix_query(i), sum);
+  }
+}
+
+TEST(container_concurrent_fenwick_tree, atomic_concurrent_updates) {
+  concurrentUpdates<AtomicFenwickTree<std::int64_t>>();
+}
+
+TEST(container_concurrent_fenwick_tree, sharded_concurrent_updates) {
+  // Less shards than threads, such that some threads share a shard.
+  concurrentUpdates<ShardedFenwickTree<std::int64_t>>(4);
+}
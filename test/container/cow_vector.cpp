@@ -0,0 +1,121 @@
+#include "container/cow_vector.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(container_cow_vector, copy_shares_elements) {
+  std::vector<int> reference(1000);
+  std::iota(reference.begin(), reference.end(), 0);
+  strobe::CowVector<int> vec{reference};
+  EXPECT_EQ(vec.use_count(), 1);
+
+  const strobe::CowVector<int> copy = vec;
+  EXPECT_EQ(vec.use_count(), 2);
+  EXPECT_EQ(std::as_const(vec).data(), copy.data());
+
+  strobe::CowVector<int> assigned;
+  assigned = copy;
+  EXPECT_EQ(copy.use_count(), 3);
+  EXPECT_EQ(assigned.cbegin(), copy.cbegin());
+  EXPECT_TRUE(std::ranges::equal(copy, reference));
+}
+
+TEST(container_cow_vector, first_write_clones) {
+  strobe::CowVector<int> vec(100, 7);
+  const strobe::CowVector<int> snapshot = vec;
+  ASSERT_EQ(snapshot.use_count(), 2);
+
+  vec[5] = 42;
+  EXPECT_EQ(vec.use_count(), 1);
+  EXPECT_EQ(snapshot.use_count(), 1);
+  EXPECT_NE(std::as_const(vec).data(), snapshot.data());
+  EXPECT_EQ(vec[5], 42);
+  EXPECT_EQ(snapshot[5], 7);
+
+  // Writes to a unique vector don't clone again.
+  const int *data = std::as_const(vec).data();
+  vec[6] = 43;
+  EXPECT_EQ(std::as_const(vec).data(), data);
+
+  strobe::CowVector<int> pushed = snapshot;
+  pushed.push_back(pushed[0]);
+  EXPECT_EQ(pushed.size(), 101);
+  EXPECT_EQ(pushed.back(), 7);
+  EXPECT_EQ(snapshot.size(), 100);
+
+  strobe::CowVector<int> popped = snapshot;
+  popped.pop_back();
+  EXPECT_EQ(popped.size(), 99);
+  EXPECT_EQ(snapshot.size(), 100);
+
+  strobe::CowVector<int> cleared = snapshot;
+  cleared.clear();
+  EXPECT_TRUE(cleared.empty());
+  EXPECT_EQ(snapshot.size(), 100);
+  EXPECT_EQ(snapshot.use_count(), 1);
+}
+
+TEST(container_cow_vector, range_insertion) {
+  strobe::CowVector<int> vec{std::vector<int>{1, 5}};
+  const strobe::CowVector<int> snapshot = vec;
+  auto it = vec.insert(vec.cbegin() + 1, std::vector<int>{2, 3, 4});
+  EXPECT_EQ(*it, 2);
+  EXPECT_TRUE(std::ranges::equal(vec, std::vector<int>{1, 2, 3, 4, 5}));
+  EXPECT_TRUE(std::ranges::equal(snapshot, std::vector<int>{1, 5}));
+  vec.append(std::list<int>{6, 7});
+  EXPECT_TRUE(
+      std::ranges::equal(vec, std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(container_cow_vector, owning_elements) {
+  auto shared = std::make_shared<int>(1);
+  {
+    strobe::CowVector<std::shared_ptr<int>> vec;
+    for (int i = 0; i < 100; ++i) {
+      vec.push_back(shared);
+    }
+    EXPECT_EQ(shared.use_count(), 101);
+    strobe::CowVector<std::shared_ptr<int>> copy = vec;
+    EXPECT_EQ(shared.use_count(), 101);
+    copy.resize(50);
+    EXPECT_EQ(shared.use_count(), 151);
+    vec = std::move(copy);
+    EXPECT_EQ(shared.use_count(), 51);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+
+  strobe::CowVector<std::string> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back(32, static_cast<char>('a' + i % 26));
+  }
+  strobe::CowVector<std::string> copy = strings;
+  copy[0] = "x";
+  EXPECT_EQ(copy[0], "x");
+  EXPECT_EQ(strings[0], std::string(32, 'a'));
+}
+
+TEST(container_cow_vector, concurrent_snapshots) {
+  std::vector<int> reference(1 << 12);
+  std::iota(reference.begin(), reference.end(), 0);
+  const strobe::CowVector<int> table{reference};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&table, t] {
+      for (int i = 0; i < 10000; ++i) {
+        strobe::CowVector<int> snapshot = table;
+        ASSERT_EQ(snapshot[(i * 31) % snapshot.size()], (i * 31) % (1 << 12));
+        if (i % 100 == t) {
+          snapshot[0] = -1;
+          ASSERT_EQ(table[0], 0);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(table.use_count(), 1);
+}
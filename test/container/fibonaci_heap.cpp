@@ -1,4 +1,5 @@
 #include "container/fibonaci_heap.hpp"
+#include "heap_test.hpp"
 #include <gtest/gtest.h>
 #include <random>
 #include <set>
@@ -8,22 +9,6 @@
 
 // ---------- Helpers ----------
 
-struct Tracked {
-  int x = 0;
-  static inline std::atomic<int> alive{0};
-
-  Tracked() : x(0) { ++alive; }
-  explicit Tracked(int v) : x(v) { ++alive; }
-  Tracked(const Tracked& o) : x(o.x) { ++alive; }
-  Tracked(Tracked&& o) noexcept : x(o.x) { ++alive; }
-  Tracked& operator=(const Tracked& o) { x = o.x; return *this; }
-  Tracked& operator=(Tracked&& o) noexcept { x = o.x; return *this; }
-  ~Tracked() { --alive; }
-
-  bool operator<(const Tracked& other) const { return x < other.x; }
-  bool operator==(const Tracked& other) const { return x == other.x; }
-};
-
 struct StatefulGreater {
   int bias = 0; // state to verify comparator storage is respected
   bool operator()(int a, int b) const { return (a + bias) > (b + bias); }
@@ -789,3 +774,76 @@ TEST(container_fibonaci_heap, many_cuts_then_pop_all) {
   }
   EXPECT_TRUE(q.empty());
 }
+
+TEST(container_fibonaci_heap, clear_and_destructor_destroy_all_elements) {
+  CheckNoLeaks guard;
+  {
+    strobe::FibonaciHeap<Tracked> q;
+    for (int i = 0; i < 1000; ++i) {
+      q.push(Tracked(i * 7919 % 1000));
+    }
+    q.pop(); // Builds trees, such that clear has to visit children.
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(Tracked::alive.load(), 0);
+
+    for (int i = 0; i < 100; ++i) {
+      q.push(Tracked(i));
+    }
+    q.pop();
+    EXPECT_EQ(q.top().x, 1);
+  }
+  EXPECT_EQ(Tracked::alive.load(), 0);
+}
+
+TEST(container_fibonaci_heap, mallocator_backed) {
+  strobe::FibonaciHeap<int, std::less<int>, strobe::Mallocator> q;
+  std::vector<strobe::FibonaciHeap<int, std::less<int>,
+                                   strobe::Mallocator>::handle> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(q.push(100 + i));
+  }
+  q.decrease_key(handles[50], 0);
+  EXPECT_EQ(q.top(), 0);
+  q.pop();
+  EXPECT_EQ(q.top(), 100);
+
+  auto moved = std::move(q);
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(moved.top(), 100);
+}
+
+TEST(container_fibonaci_heap, large_heavy_decrease_key_interleaved_with_pop) {
+  constexpr int N = 100000;
+  strobe::FibonaciHeap<std::pair<int, int>> q;
+  std::vector<strobe::FibonaciHeap<std::pair<int, int>>::handle> handles(N);
+  std::vector<int> keys(N);
+  std::vector<bool> alive(N, true);
+  std::mt19937 rng(7);
+  for (int i = 0; i < N; ++i) {
+    keys[i] = static_cast<int>(rng() % (1 << 30)) + (1 << 20);
+    handles[i] = q.push({keys[i], i});
+  }
+  std::multiset<std::pair<int, int>> ref;
+  for (int i = 0; i < N; ++i) {
+    ref.insert({keys[i], i});
+  }
+  while (!q.empty()) {
+    ASSERT_EQ(q.top(), *ref.begin());
+    const int id = q.top().second;
+    alive[id] = false;
+    ref.erase(ref.begin());
+    q.pop();
+    for (int j = 0; j < 4; ++j) {
+      const int i = static_cast<int>(rng() % N);
+      if (!alive[i]) {
+        continue;
+      }
+      ref.erase({keys[i], i});
+      keys[i] -= static_cast<int>(rng() % 1024);
+      ref.insert({keys[i], i});
+      q.decrease_key(handles[i], {keys[i], i});
+    }
+  }
+  EXPECT_TRUE(ref.empty());
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <gtest/gtest.h>
+#include <queue>
+#include <random>
+#include <vector>
+
+// Counts the living instances, to check that heaps destroy their elements.
+struct Tracked {
+  int x = 0;
+  static inline std::atomic<int> alive{0};
+
+  Tracked() : x(0) { ++alive; }
+  explicit Tracked(int v) : x(v) { ++alive; }
+  Tracked(const Tracked &o) : x(o.x) { ++alive; }
+  Tracked(Tracked &&o) noexcept : x(o.x) { ++alive; }
+  Tracked &operator=(const Tracked &o) = default;
+  Tracked &operator=(Tracked &&o) noexcept = default;
+  ~Tracked() { --alive; }
+
+  bool operator<(const Tracked &other) const { return x < other.x; }
+  bool operator==(const Tracked &other) const { return x == other.x; }
+};
+
+// Checks heaps over int with the std::priority_queue interface.
+
+template <typename Heap> void pushRangeAgainstPriorityQueue() {
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  std::vector<int> values(1000);
+  for (auto &v : values) {
+    v = dist(prng);
+  }
+  Heap heap(values);
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference(
+      values.begin(), values.end());
+  // Batches below and above the heapify threshold.
+  for (std::size_t batch : {1, 3, 7, 50, 2000, 20000}) {
+    std::vector<int> range(batch);
+    for (auto &v : range) {
+      v = dist(prng);
+      reference.push(v);
+    }
+    heap.push_range(range);
+    ASSERT_EQ(heap.size(), reference.size());
+    for (int i = 0; i < 100; ++i) {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    }
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
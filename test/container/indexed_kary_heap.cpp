@@ -0,0 +1,120 @@
+#include "container/indexed_kary_heap.hpp"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <set>
+
+TEST(container_indexed_kary_heap, simple) {
+  strobe::IndexedKAryHeap<int, 4> heap;
+
+  heap.push(0, 5);
+  heap.push(7, 3);
+  heap.push(2, 4);
+  EXPECT_TRUE(heap.contains(7));
+  EXPECT_FALSE(heap.contains(1));
+  EXPECT_FALSE(heap.contains(100));
+
+  EXPECT_EQ(heap.top(), 3);
+  EXPECT_EQ(heap.top_id(), 7);
+  heap.decrease_key(0, 1);
+  EXPECT_EQ(heap.top_id(), 0);
+  EXPECT_EQ(heap.key(0), 1);
+
+  heap.erase(7);
+  EXPECT_FALSE(heap.contains(7));
+  EXPECT_EQ(heap.size(), 2);
+
+  heap.pop();
+  EXPECT_EQ(heap.top(), 4);
+  EXPECT_EQ(heap.top_id(), 2);
+  heap.pop();
+  EXPECT_TRUE(heap.empty());
+  EXPECT_FALSE(heap.contains(2));
+}
+
+template <std::size_t K> static void randomAgainstSet() {
+  strobe::IndexedKAryHeap<unsigned int, K> heap;
+  // (key, id) pairs, ids break ties.
+  std::set<std::pair<unsigned int, std::size_t>> reference;
+  std::map<std::size_t, unsigned int> keys;
+  std::mt19937 prng(K);
+  std::uniform_int_distribution<unsigned int> key(0, 1000);
+  std::uniform_int_distribution<std::size_t> id(0, 500);
+  for (int i = 0; i < 20000; ++i) {
+    const std::size_t v = id(prng);
+    switch (prng() % 5) {
+    case 0:
+    case 1:
+      if (!heap.contains(v)) {
+        const unsigned int k = key(prng);
+        heap.push(v, k);
+        reference.emplace(k, v);
+        keys[v] = k;
+      } else {
+        const unsigned int k = keys[v] == 0 ? 0 : keys[v] - key(prng) % keys[v];
+        heap.decrease_key(v, k);
+        reference.erase({keys[v], v});
+        reference.emplace(k, v);
+        keys[v] = k;
+      }
+      break;
+    case 2:
+      if (heap.contains(v)) {
+        const unsigned int k = key(prng);
+        heap.push_or_update(v, k);
+        reference.erase({keys[v], v});
+        reference.emplace(k, v);
+        keys[v] = k;
+      }
+      break;
+    case 3:
+      ASSERT_EQ(heap.contains(v), keys.contains(v));
+      if (heap.contains(v)) {
+        heap.erase(v);
+        reference.erase({keys[v], v});
+        keys.erase(v);
+      }
+      break;
+    case 4:
+      if (!reference.empty()) {
+        ASSERT_EQ(heap.top(), reference.begin()->first);
+        const std::size_t top = heap.top_id();
+        ASSERT_EQ(heap.key(top), heap.top());
+        reference.erase({keys[top], top});
+        keys.erase(top);
+        heap.pop();
+        ASSERT_FALSE(heap.contains(top));
+      }
+      break;
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.begin()->first);
+    reference.erase({heap.top(), heap.top_id()});
+    heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(container_indexed_kary_heap, random_against_set) {
+  randomAgainstSet<2>();
+  randomAgainstSet<3>();
+  randomAgainstSet<4>();
+  randomAgainstSet<8>();
+  randomAgainstSet<16>();
+}
+
+TEST(container_indexed_kary_heap, clear) {
+  strobe::IndexedKAryHeap<int> heap(10);
+  for (std::size_t i = 0; i < 10; ++i) {
+    heap.push(i, static_cast<int>(10 - i));
+  }
+  heap.clear();
+  EXPECT_TRUE(heap.empty());
+  for (std::size_t i = 0; i < 10; ++i) {
+    EXPECT_FALSE(heap.contains(i));
+  }
+  heap.push(3, 1);
+  EXPECT_EQ(heap.top_id(), 3);
+}
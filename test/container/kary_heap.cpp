@@ -1,5 +1,10 @@
 #include "container/kary_heap.hpp"
+#include "container/select_child.hpp"
+#include "heap_test.hpp"
 #include <gtest/gtest.h>
+#include <memory>
+#include <queue>
+#include <random>
 
 
 TEST(container_kary_heap, simple) {
@@ -20,3 +25,203 @@ TEST(container_kary_heap, simple) {
   heap.pop();
   EXPECT_TRUE(heap.empty());
 }
+
+template <std::size_t K> static void randomAgainstPriorityQueue() {
+  strobe::KAryHeap<int, K> heap;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+  std::mt19937 prng(K);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  for (int i = 0; i < 10000; ++i) {
+    if (reference.empty() || prng() % 3 != 0) {
+      const int v = dist(prng);
+      heap.push(v);
+      reference.push(v);
+    } else {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(container_kary_heap, random_against_priority_queue) {
+  randomAgainstPriorityQueue<2>();
+  randomAgainstPriorityQueue<3>();
+  randomAgainstPriorityQueue<4>();
+  randomAgainstPriorityQueue<8>();
+  randomAgainstPriorityQueue<16>();
+}
+
+template <typename T, std::size_t K, typename Compare>
+static void selectChildAgainstScalar() {
+  static_assert(strobe::simd_select_child_v<T, K, Compare>);
+  std::mt19937 prng(K);
+  // Small value range, such that ties are common.
+  std::uniform_int_distribution<int> dist(-8, 8);
+  T children[K];
+  for (int i = 0; i < 1000; ++i) {
+    for (auto &c : children) {
+      c = static_cast<T>(dist(prng));
+    }
+    ASSERT_EQ((strobe::select_child<T, K>(children, Compare{})),
+              (strobe::select_child_scalar<T, K>(children, Compare{})));
+  }
+}
+
+TEST(container_kary_heap, simd_select_child) {
+  selectChildAgainstScalar<int, 8, std::less<int>>();
+  selectChildAgainstScalar<int, 16, std::greater<int>>();
+  selectChildAgainstScalar<unsigned int, 8, std::greater<unsigned int>>();
+  selectChildAgainstScalar<unsigned int, 32, std::less<unsigned int>>();
+  selectChildAgainstScalar<float, 8, std::less<float>>();
+  selectChildAgainstScalar<float, 16, std::less<float>>();
+  selectChildAgainstScalar<float, 24, std::greater<float>>();
+}
+
+TEST(container_kary_heap, simd_greater_float) {
+  strobe::KAryHeap<float, 16, strobe::Vector<float>, std::greater<float>>
+      heap;
+  std::priority_queue<float> reference;
+  std::mt19937 prng(0);
+  std::uniform_real_distribution<float> dist;
+  for (int i = 0; i < 10000; ++i) {
+    if (reference.empty() || prng() % 3 != 0) {
+      const float v = dist(prng);
+      heap.push(v);
+      reference.push(v);
+    } else {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    }
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+}
+
+TEST(container_kary_heap, owning_elements) {
+  struct Less {
+    bool operator()(const std::unique_ptr<int> &a,
+                    const std::unique_ptr<int> &b) const {
+      return *a < *b;
+    }
+  };
+  strobe::KAryHeap<std::unique_ptr<int>, 4,
+                   strobe::Vector<std::unique_ptr<int>>, Less>
+      heap;
+  for (int v : {5, 3, 8, 1, 9, 2, 7}) {
+    heap.push(std::make_unique<int>(v));
+  }
+  for (int v : {1, 2, 3, 5}) {
+    ASSERT_EQ(*heap.top(), v);
+    heap.pop();
+  }
+  for (int v : {7, 8, 9}) {
+    std::unique_ptr<int> top = heap.pop_top();
+    ASSERT_EQ(*top, v);
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+template <std::size_t K> static void cacheAlignedAgainstPriorityQueue() {
+  strobe::CacheAlignedKAryHeap<int, K> heap;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+  std::mt19937 prng(K);
+  std::uniform_int_distribution<int> dist(0, 1000);
+  for (int i = 0; i < 10000; ++i) {
+    if (reference.empty() || prng() % 3 != 0) {
+      const int v = dist(prng);
+      heap.push(v);
+      reference.push(v);
+    } else {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+    // The buffer is cache line aligned and the first sibling group (the
+    // children of the root) starts at index K.
+    if (!heap.empty()) {
+      const int *buffer = &heap.top() - (K - 1);
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 64, 0);
+    }
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+
+  // A moved from heap is empty and can be reused.
+  heap.push(1);
+  auto moved = std::move(heap);
+  EXPECT_EQ(moved.size(), 1);
+  EXPECT_TRUE(heap.empty());
+  heap.push(2);
+  EXPECT_EQ(heap.top(), 2);
+}
+
+TEST(container_kary_heap, cache_aligned) {
+  cacheAlignedAgainstPriorityQueue<2>();
+  cacheAlignedAgainstPriorityQueue<4>();
+  cacheAlignedAgainstPriorityQueue<8>();
+  cacheAlignedAgainstPriorityQueue<16>();
+}
+
+TEST(container_kary_heap, push_range) {
+  pushRangeAgainstPriorityQueue<strobe::KAryHeap<int, 2>>();
+  pushRangeAgainstPriorityQueue<strobe::KAryHeap<int, 3>>();
+  pushRangeAgainstPriorityQueue<strobe::KAryHeap<int, 4>>();
+  pushRangeAgainstPriorityQueue<strobe::KAryHeap<int, 8>>();
+  pushRangeAgainstPriorityQueue<strobe::CacheAlignedKAryHeap<int, 8>>();
+  pushRangeAgainstPriorityQueue<strobe::KAryHeap<int, 16>>();
+}
+
+template <typename Heap> static void meldAgainstPriorityQueue() {
+  for (std::size_t lhs : {0, 1, 10, 1000}) {
+    for (std::size_t rhs : {0, 1, 10, 1000}) {
+      std::mt19937 prng(lhs * 31 + rhs);
+      Heap a;
+      Heap b;
+      std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+      for (std::size_t i = 0; i < lhs; ++i) {
+        const int v = static_cast<int>(prng() % 1000);
+        a.push(v);
+        reference.push(v);
+      }
+      for (std::size_t i = 0; i < rhs; ++i) {
+        const int v = static_cast<int>(prng() % 1000);
+        b.push(v);
+        reference.push(v);
+      }
+      a.meld(std::move(b));
+      EXPECT_TRUE(b.empty());
+      ASSERT_EQ(a.size(), reference.size());
+      while (!reference.empty()) {
+        ASSERT_EQ(a.top(), reference.top());
+        a.pop();
+        reference.pop();
+      }
+      // b is still usable.
+      b.push(1);
+      EXPECT_EQ(b.top(), 1);
+    }
+  }
+}
+
+TEST(container_kary_heap, meld) {
+  meldAgainstPriorityQueue<strobe::KAryHeap<int, 4>>();
+  meldAgainstPriorityQueue<strobe::KAryHeap<int, 8>>();
+  meldAgainstPriorityQueue<strobe::CacheAlignedKAryHeap<int, 8>>();
+}
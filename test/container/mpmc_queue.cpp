@@ -0,0 +1,91 @@
+#include "container/mpmc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(container_mpmc_queue, simple) {
+  strobe::MpmcQueue<int> queue(4);
+  EXPECT_EQ(queue.capacity(), 4);
+  EXPECT_FALSE(queue.try_dequeue().has_value());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_enqueue(i));
+  }
+  EXPECT_FALSE(queue.try_enqueue(4)) << "Ring should be full";
+  EXPECT_EQ(queue.size(), 4);
+  for (int round = 0; round < 10; ++round) {
+    EXPECT_EQ(queue.dequeue(), round);
+    queue.enqueue(round + 4);
+  }
+  for (int i = 10; i < 14; ++i) {
+    EXPECT_EQ(queue.dequeue(), i);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(container_mpmc_queue, non_trivial_elements) {
+  auto queue = std::make_unique<strobe::MpmcQueue<std::string>>(8);
+  for (int i = 0; i < 6; ++i) {
+    queue->try_emplace(64, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(queue->dequeue(), std::string(64, 'a'));
+  // The remaining strings are destroyed with the queue.
+  queue.reset();
+}
+
+// Every producer enqueues an increasing sequence, every consumer must see
+// the elements of each producer in order and all elements exactly once.
+TEST(container_mpmc_queue, stress) {
+  constexpr std::uint64_t Producers = 4;
+  constexpr std::uint64_t Consumers = 4;
+  constexpr std::uint64_t PerProducer = 100000;
+  strobe::MpmcQueue<std::uint64_t> queue(64);
+
+  std::atomic<std::uint64_t> consumed{0};
+  std::vector<std::vector<std::uint64_t>> seen(Consumers);
+  std::vector<std::thread> threads;
+  for (std::uint64_t p = 0; p < Producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (std::uint64_t i = 0; i < PerProducer; ++i) {
+        queue.enqueue(p << 32 | i);
+      }
+    });
+  }
+  std::atomic<bool> ordered{true};
+  for (std::uint64_t c = 0; c < Consumers; ++c) {
+    threads.emplace_back([&, c] {
+      std::vector<std::uint64_t> last(Producers, 0);
+      while (consumed.load() < Producers * PerProducer) {
+        auto v = queue.try_dequeue();
+        if (!v.has_value()) {
+          std::this_thread::yield();
+          continue;
+        }
+        consumed.fetch_add(1);
+        const std::uint64_t p = *v >> 32;
+        const std::uint64_t i = *v & 0xFFFFFFFF;
+        if (i + 1 <= last[p]) {
+          ordered = false;
+        }
+        last[p] = i + 1;
+        seen[c].push_back(*v);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(ordered) << "Elements of a producer were reordered";
+  std::vector<std::uint64_t> all;
+  for (const auto &s : seen) {
+    all.insert(all.end(), s.begin(), s.end());
+  }
+  std::ranges::sort(all);
+  ASSERT_EQ(all.size(), Producers * PerProducer);
+  EXPECT_EQ(std::ranges::adjacent_find(all), all.end()) << "Duplicates";
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,64 @@
+#include "container/mpsc_queue.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(container_mpsc_queue, simple) {
+  strobe::MpscQueue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_dequeue().has_value());
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      queue.enqueue(i);
+    }
+    EXPECT_FALSE(queue.empty());
+    for (int i = 0; i < 1000; ++i) {
+      EXPECT_EQ(queue.dequeue(), i);
+    }
+    EXPECT_TRUE(queue.empty());
+  }
+}
+
+TEST(container_mpsc_queue, non_trivial_elements) {
+  auto queue = std::make_unique<strobe::MpscQueue<std::string>>();
+  for (int i = 0; i < 6; ++i) {
+    queue->emplace(64, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(queue->dequeue(), std::string(64, 'a'));
+  EXPECT_EQ(queue->dequeue(), std::string(64, 'b'));
+  // The remaining strings are destroyed with the queue.
+  queue.reset();
+}
+
+// Every producer enqueues an increasing sequence, which the consumer must
+// see in order.
+TEST(container_mpsc_queue, stress) {
+  constexpr std::uint64_t Producers = 8;
+  constexpr std::uint64_t PerProducer = 100000;
+  // Less pools than producers, such that pools are shared.
+  strobe::MpscQueue<std::uint64_t, 4> queue;
+
+  std::vector<std::thread> producers;
+  for (std::uint64_t p = 0; p < Producers; ++p) {
+    producers.emplace_back([&, p] {
+      for (std::uint64_t i = 0; i < PerProducer; ++i) {
+        queue.enqueue(p << 32 | i);
+      }
+    });
+  }
+  std::vector<std::uint64_t> next(Producers, 0);
+  bool ordered = true;
+  for (std::uint64_t n = 0; n < Producers * PerProducer; ++n) {
+    const std::uint64_t v = queue.dequeue();
+    const std::uint64_t p = v >> 32;
+    ordered &= (v & 0xFFFFFFFF) == next[p]++;
+  }
+  for (auto &thread : producers) {
+    thread.join();
+  }
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,119 @@
+#include "container/multi_queue.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(container_multi_queue, single_queue_is_exact) {
+  strobe::MultiQueue<int> queue(1, 1);
+  ASSERT_EQ(queue.queue_count(), 1);
+  std::mt19937 prng(0);
+  std::vector<int> values(1000);
+  for (int &v : values) {
+    v = prng() % 100;
+    queue.push(v);
+  }
+  EXPECT_EQ(queue.size(), values.size());
+  std::ranges::sort(values);
+  for (int v : values) {
+    auto top = queue.try_pop();
+    ASSERT_TRUE(top.has_value());
+    EXPECT_EQ(*top, v);
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(container_multi_queue, relaxed_pops_all_elements) {
+  strobe::MultiQueue<int, std::greater<int>> queue(4);
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+  for (int v : values) {
+    queue.push(v);
+  }
+  std::vector<int> popped;
+  while (auto top = queue.try_pop()) {
+    popped.push_back(*top);
+  }
+  EXPECT_TRUE(queue.empty());
+  // Pops are roughly descending, the first element is one of the largest.
+  ASSERT_EQ(popped.size(), values.size());
+  EXPECT_GE(popped.front(), 1000 - 100);
+  std::ranges::sort(popped);
+  EXPECT_EQ(popped, values);
+}
+
+TEST(container_multi_queue, move_only_elements) {
+  struct Less {
+    bool operator()(const std::unique_ptr<int> &a,
+                    const std::unique_ptr<int> &b) const {
+      return *a < *b;
+    }
+  };
+  strobe::MultiQueue<std::unique_ptr<int>, Less> queue(1, 1);
+  for (int v : {5, 3, 8, 1}) {
+    queue.push(std::make_unique<int>(v));
+  }
+  for (int v : {1, 3, 5, 8}) {
+    std::optional<std::unique_ptr<int>> top = queue.try_pop();
+    ASSERT_TRUE(top.has_value());
+    EXPECT_EQ(**top, v);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(container_multi_queue, concurrent_push_pop) {
+  constexpr int ThreadCount = 8;
+  constexpr int PerThread = 10000;
+  strobe::MultiQueue<int> queue(ThreadCount);
+
+  std::vector<std::vector<int>> popped(ThreadCount);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < ThreadCount; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < PerThread; ++i) {
+        queue.push(t * PerThread + i);
+        if (i % 2 == 1) {
+          // Can only fail spuriously, if other threads empty the queues
+          // while this thread scans them.
+          if (auto top = queue.try_pop()) {
+            popped[t].push_back(*top);
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+  std::size_t poppedCount = 0;
+  for (const auto &p : popped) {
+    poppedCount += p.size();
+  }
+  EXPECT_EQ(queue.size(), ThreadCount * PerThread - poppedCount);
+  for (int t = 0; t < ThreadCount; ++t) {
+    threads.emplace_back([&, t] {
+      while (auto top = queue.try_pop()) {
+        popped[t].push_back(*top);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(queue.empty());
+
+  std::vector<int> all;
+  for (const auto &p : popped) {
+    all.insert(all.end(), p.begin(), p.end());
+  }
+  std::ranges::sort(all);
+  std::vector<int> expected(ThreadCount * PerThread);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(all, expected) << "Elements were lost or duplicated";
+}
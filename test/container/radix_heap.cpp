@@ -0,0 +1,114 @@
+#include "container/radix_heap.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+TEST(container_radix_heap, simple) {
+  strobe::RadixHeap<unsigned int> heap;
+
+  heap.push(1);
+  heap.push(3);
+  heap.push(2);
+
+  EXPECT_EQ(heap.top(), 1);
+  heap.pop();
+  EXPECT_EQ(heap.top(), 2);
+  heap.pop();
+  EXPECT_EQ(heap.top(), 3);
+
+  EXPECT_EQ(heap.size(), 1);
+  heap.pop();
+  EXPECT_TRUE(heap.empty());
+}
+
+template <typename K, typename Dist>
+static void monotoneAgainstPriorityQueue(K start, Dist delta) {
+  strobe::RadixHeap<K> heap;
+  std::priority_queue<K, std::vector<K>, std::greater<K>> reference;
+  std::mt19937 prng(0);
+  std::uniform_int_distribution<int> choice(0, 2);
+
+  heap.push(start);
+  reference.push(start);
+  for (int i = 0; i < 100000; ++i) {
+    if (choice(prng) == 0 && !reference.empty()) {
+      ASSERT_EQ(heap.top(), reference.top());
+      heap.pop();
+      reference.pop();
+    } else {
+      // Monotone, never push below the current minimum.
+      const K base = reference.empty() ? start : reference.top();
+      const K k = static_cast<K>(base + delta(prng));
+      heap.push(k);
+      reference.push(k);
+    }
+    ASSERT_EQ(heap.size(), reference.size());
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(heap.top(), reference.top());
+    heap.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(container_radix_heap, monotone_unsigned) {
+  monotoneAgainstPriorityQueue<std::uint32_t>(
+      0, std::uniform_int_distribution<std::uint32_t>(0, 1000));
+  monotoneAgainstPriorityQueue<std::uint64_t>(
+      std::uint64_t(1) << 40,
+      std::uniform_int_distribution<std::uint64_t>(0, 1 << 20));
+}
+
+TEST(container_radix_heap, monotone_signed) {
+  monotoneAgainstPriorityQueue<int>(
+      -50000, std::uniform_int_distribution<int>(0, 100));
+}
+
+TEST(container_radix_heap, monotone_float) {
+  monotoneAgainstPriorityQueue<float>(
+      -1000.0f, std::uniform_real_distribution<float>(0.0f, 10.0f));
+  monotoneAgainstPriorityQueue<double>(
+      -1.0, std::uniform_real_distribution<double>(0.0, 1e-3));
+}
+
+TEST(container_radix_heap, key_projection) {
+  struct Event {
+    double time;
+    std::unique_ptr<int> payload;
+  };
+  struct EventTime {
+    double operator()(const Event &e) const { return e.time; }
+  };
+  strobe::RadixHeap<Event, EventTime> heap;
+  heap.push(Event{2.5, std::make_unique<int>(2)});
+  heap.push(Event{0.5, std::make_unique<int>(0)});
+  heap.push(Event{1.5, std::make_unique<int>(1)});
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(*heap.top().payload, i);
+    heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+
+  // A empty heap accepts any key.
+  heap.push(Event{-4.0, std::make_unique<int>(4)});
+  EXPECT_EQ(*heap.top().payload, 4);
+}
+
+TEST(container_radix_heap, top_does_not_advance_last) {
+  strobe::RadixHeap<unsigned int> heap;
+  heap.push(0);
+  heap.pop();
+  heap.push(20);
+  heap.push(30);
+  EXPECT_EQ(heap.top(), 20);
+  // 15 is above the last popped key, peeking at 20 must not change that.
+  heap.push(15);
+  for (unsigned int expected : {15u, 20u, 30u}) {
+    ASSERT_EQ(heap.top(), expected);
+    heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
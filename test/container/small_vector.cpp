@@ -0,0 +1,102 @@
+#include "container/small_vector.hpp"
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CountingAllocator {
+  static inline int allocations = 0;
+  static constexpr bool is_always_equal = true;
+  void *allocate(std::size_t size, std::size_t) {
+    ++allocations;
+    return std::malloc(size);
+  }
+  void deallocate(void *ptr, std::size_t, std::size_t) { std::free(ptr); }
+};
+
+} // namespace
+
+TEST(container_small_vector, no_allocation_while_inline) {
+  CountingAllocator::allocations = 0;
+  strobe::SmallVector<std::uint64_t, 3, CountingAllocator> vec;
+  vec.push_back(1);
+  vec.push_back(2);
+  vec.push_back(3);
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(CountingAllocator::allocations, 0);
+
+  vec.push_back(4);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(CountingAllocator::allocations, 1);
+  for (std::uint64_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(vec[i], i + 1);
+  }
+}
+
+TEST(container_small_vector, move_inline_and_allocated) {
+  strobe::SmallVector<std::string, 2> small;
+  small.push_back("a");
+  small.push_back("b");
+  strobe::SmallVector<std::string, 2> movedSmall{std::move(small)};
+  EXPECT_TRUE(movedSmall.is_inline());
+  ASSERT_EQ(movedSmall.size(), 2);
+  EXPECT_EQ(movedSmall[0], "a");
+  EXPECT_EQ(movedSmall[1], "b");
+  EXPECT_TRUE(small.empty());
+
+  strobe::SmallVector<std::string, 2> large;
+  for (int i = 0; i < 10; ++i) {
+    large.push_back(std::to_string(i));
+  }
+  const std::string *data = &large[0];
+  strobe::SmallVector<std::string, 2> movedLarge{std::move(large)};
+  EXPECT_EQ(&movedLarge[0], data) << "Allocated buffers should be stolen";
+  EXPECT_TRUE(large.empty());
+  EXPECT_TRUE(large.is_inline());
+
+  movedSmall = std::move(movedLarge);
+  ASSERT_EQ(movedSmall.size(), 10);
+  EXPECT_EQ(movedSmall[9], "9");
+  movedLarge = movedSmall;
+  EXPECT_EQ(movedLarge.size(), 10);
+  EXPECT_EQ(movedLarge[5], "5");
+}
+
+TEST(container_small_vector, insert_and_pop_front) {
+  strobe::SmallVector<std::string, 4> vec;
+  vec.push_back("b");
+  vec.push_back("d");
+  vec.insert(vec.begin(), std::string("a"));
+  vec.insert(vec.begin() + 2, std::string("c"));
+  EXPECT_TRUE(vec.is_inline());
+  // Spills while inserting.
+  vec.insert(vec.begin() + 4, std::vector<std::string>{"e", "f", "g"});
+  EXPECT_FALSE(vec.is_inline());
+  // Insert a reference into the vector itself.
+  vec.insert(vec.begin(), vec[6]);
+  std::vector<std::string> expected{"g", "a", "b", "c", "d", "e", "f", "g"};
+  ASSERT_TRUE(std::ranges::equal(vec, expected));
+
+  vec.pop_front();
+  vec.pop_front();
+  EXPECT_EQ(vec.front(), "b");
+  EXPECT_EQ(vec.size(), 6);
+}
+
+TEST(container_small_vector, owning_elements) {
+  auto shared = std::make_shared<int>(1);
+  {
+    strobe::SmallVector<std::shared_ptr<int>, 4> vec;
+    for (int i = 0; i < 16; ++i) {
+      vec.push_back(shared);
+    }
+    vec.insert(vec.begin() + 3, shared);
+    vec.pop_front();
+    EXPECT_TRUE(vec.remove(shared));
+    EXPECT_EQ(shared.use_count(), 16);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
@@ -0,0 +1,120 @@
+#include "container/spsc_queue.hpp"
+#include "memory/PageAllocator.hpp"
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(container_spsc_queue, simple) {
+  strobe::SpscQueue<int> queue(4);
+  EXPECT_EQ(queue.capacity(), 4);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.try_dequeue().has_value());
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_enqueue(i));
+  }
+  EXPECT_FALSE(queue.try_enqueue(4)) << "Ring should be full";
+  EXPECT_EQ(queue.size(), 4);
+  EXPECT_EQ(queue.peek(), 0);
+  EXPECT_EQ(queue.dequeue(), 0);
+  EXPECT_TRUE(queue.try_enqueue(4));
+  for (int i = 1; i <= 4; ++i) {
+    auto v = queue.try_dequeue();
+    ASSERT_TRUE(v.has_value());
+    EXPECT_EQ(*v, i);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(container_spsc_queue, capacity_is_power_of_two) {
+  strobe::SpscQueue<int> queue(100);
+  EXPECT_EQ(queue.capacity(), 128);
+}
+
+TEST(container_spsc_queue, bulk_wraps_around) {
+  strobe::SpscQueue<std::uint64_t> queue(16);
+  std::vector<std::uint64_t> values(10);
+  std::vector<std::uint64_t> out(10);
+  std::uint64_t next = 0;
+  std::uint64_t expected = 0;
+  for (int round = 0; round < 100; ++round) {
+    for (auto &v : values) {
+      v = next++;
+    }
+    // Only a prefix fits if the ring is more than half full.
+    const std::size_t n = queue.enqueue_bulk(values);
+    next -= values.size() - n;
+    EXPECT_LE(queue.size(), queue.capacity());
+    const std::size_t m = queue.dequeue_bulk(std::span(out).first(7));
+    for (std::size_t i = 0; i < m; ++i) {
+      ASSERT_EQ(out[i], expected++);
+    }
+  }
+  while (auto v = queue.try_dequeue()) {
+    ASSERT_EQ(*v, expected++);
+  }
+  EXPECT_EQ(expected, next);
+}
+
+TEST(container_spsc_queue, non_trivial_elements) {
+  auto queue = std::make_unique<strobe::SpscQueue<std::string>>(8);
+  for (int i = 0; i < 6; ++i) {
+    queue->emplace(64, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(queue->dequeue(), std::string(64, 'a'));
+  std::array<std::string, 2> out;
+  EXPECT_EQ(queue->dequeue_bulk(out), 2);
+  EXPECT_EQ(out[1], std::string(64, 'c'));
+  // The remaining strings are destroyed with the queue.
+  queue.reset();
+}
+
+TEST(container_spsc_queue, move_only_elements) {
+  strobe::SpscQueue<std::unique_ptr<int>> queue(2);
+  auto first = std::make_unique<int>(1);
+  queue.emplace(std::move(first));
+  EXPECT_EQ(first, nullptr);
+  queue.enqueue(std::make_unique<int>(2));
+  EXPECT_EQ(*queue.dequeue(), 1);
+  EXPECT_EQ(*queue.dequeue(), 2);
+}
+
+TEST(container_spsc_queue, concurrent_producer_consumer) {
+  constexpr std::uint64_t N = 1 << 20;
+  strobe::SpscQueue<std::uint64_t, strobe::PageAllocator> queue(1 << 12);
+
+  std::thread producer([&] {
+    std::array<std::uint64_t, 64> batch;
+    std::uint64_t next = 0;
+    while (next < N) {
+      if (next % 3 == 0) {
+        queue.enqueue(next++);
+        continue;
+      }
+      const std::size_t n = std::min<std::uint64_t>(batch.size(), N - next);
+      std::iota(batch.begin(), batch.begin() + n, next);
+      next += queue.enqueue_bulk(std::span(batch).first(n));
+    }
+  });
+  std::array<std::uint64_t, 48> out;
+  std::uint64_t expected = 0;
+  bool ordered = true;
+  while (expected < N) {
+    if (expected % 5 == 0) {
+      ordered &= queue.dequeue() == expected++;
+      continue;
+    }
+    const std::size_t n = queue.dequeue_bulk(out);
+    for (std::size_t i = 0; i < n; ++i) {
+      ordered &= out[i] == expected++;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(queue.empty());
+}
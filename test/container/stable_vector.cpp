@@ -0,0 +1,125 @@
+#include "container/stable_vector.hpp"
+#include "container/binary_heap.hpp"
+#include "container/kary_heap.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(container_stable_vector, pointer_stability) {
+  strobe::StableVector<int, strobe::Mallocator, 4> vec;
+  std::vector<int *> ptrs;
+  for (int i = 0; i < 10000; ++i) {
+    ptrs.push_back(&vec.emplace_back(i));
+  }
+  ASSERT_EQ(vec.size(), 10000);
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(ptrs[i], &vec[i]);
+    ASSERT_EQ(*ptrs[i], i);
+  }
+  // Moving the container does not move the elements.
+  strobe::StableVector<int, strobe::Mallocator, 4> moved = std::move(vec);
+  EXPECT_TRUE(vec.empty());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(ptrs[i], &moved[i]);
+  }
+}
+
+TEST(container_stable_vector, segment_boundaries) {
+  strobe::StableVector<std::size_t, strobe::Mallocator, 2> vec;
+  EXPECT_EQ(vec.capacity(), 0);
+  vec.reserve(1);
+  EXPECT_EQ(vec.capacity(), 2);
+  vec.reserve(3);
+  EXPECT_EQ(vec.capacity(), 6);
+  vec.reserve(7);
+  EXPECT_EQ(vec.capacity(), 14);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+  }
+  for (std::size_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(vec[i], i);
+  }
+  EXPECT_EQ(vec.front(), 0);
+  EXPECT_EQ(vec.back(), 999);
+  vec.resize(10);
+  EXPECT_EQ(vec.size(), 10);
+  vec.resize(100, 42);
+  EXPECT_EQ(vec[9], 9);
+  EXPECT_EQ(vec[10], 42);
+  EXPECT_EQ(vec[99], 42);
+}
+
+TEST(container_stable_vector, iterators) {
+  strobe::StableVector<int, strobe::Mallocator, 4> vec;
+  std::mt19937 prng(7);
+  std::vector<int> reference;
+  for (int i = 0; i < 1000; ++i) {
+    const int v = static_cast<int>(prng() % 500);
+    vec.push_back(v);
+    reference.push_back(v);
+  }
+  EXPECT_TRUE(std::equal(vec.begin(), vec.end(), reference.begin()));
+  std::sort(vec.begin(), vec.end());
+  std::sort(reference.begin(), reference.end());
+  EXPECT_TRUE(std::equal(vec.begin(), vec.end(), reference.begin()));
+  EXPECT_TRUE(std::equal(vec.rbegin(), vec.rend(), reference.rbegin()));
+  EXPECT_EQ(vec.end() - vec.begin(), 1000);
+  EXPECT_EQ(std::accumulate(vec.cbegin(), vec.cend(), 0),
+            std::accumulate(reference.begin(), reference.end(), 0));
+}
+
+TEST(container_stable_vector, owning_elements) {
+  strobe::StableVector<std::string, strobe::Mallocator, 2> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+  }
+  strobe::StableVector<std::string, strobe::Mallocator, 2> copy = vec;
+  ASSERT_EQ(copy.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(copy[i], vec[i]);
+  }
+  copy.resize(3);
+  copy = vec;
+  EXPECT_EQ(copy.size(), 100);
+  EXPECT_TRUE(copy.remove(vec[50]));
+  EXPECT_EQ(copy.size(), 99);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+  vec.push_back("x");
+  EXPECT_EQ(vec.front(), "x");
+}
+
+TEST(container_stable_vector, heap_container) {
+  strobe::BinaryHeap<int, strobe::StableVector<int>> binary;
+  strobe::KAryHeap<int, 4, strobe::StableVector<int>> kary;
+  std::priority_queue<int, std::vector<int>, std::greater<int>> reference;
+  std::mt19937 prng(3);
+  for (int i = 0; i < 10000; ++i) {
+    if (reference.empty() || prng() % 3 != 0) {
+      const int v = static_cast<int>(prng() % 1000);
+      binary.push(v);
+      kary.push(v);
+      reference.push(v);
+    } else {
+      ASSERT_EQ(binary.top(), reference.top());
+      ASSERT_EQ(kary.top(), reference.top());
+      binary.pop();
+      kary.pop();
+      reference.pop();
+    }
+  }
+  while (!reference.empty()) {
+    ASSERT_EQ(binary.top(), reference.top());
+    ASSERT_EQ(kary.top(), reference.top());
+    binary.pop();
+    kary.pop();
+    reference.pop();
+  }
+  EXPECT_TRUE(binary.empty());
+  EXPECT_TRUE(kary.empty());
+}
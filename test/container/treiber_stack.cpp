@@ -0,0 +1,75 @@
+#include "container/treiber_stack.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(container_treiber_stack, simple) {
+  strobe::TreiberStack<int> stack;
+  EXPECT_TRUE(stack.empty());
+  EXPECT_FALSE(stack.try_pop().has_value());
+  // More elements than fit into one block of nodes.
+  for (int i = 0; i < 1000; ++i) {
+    stack.push(i);
+  }
+  for (int i = 999; i >= 0; --i) {
+    auto v = stack.try_pop();
+    ASSERT_TRUE(v.has_value());
+    EXPECT_EQ(*v, i);
+  }
+  EXPECT_TRUE(stack.empty());
+}
+
+TEST(container_treiber_stack, non_trivial_elements) {
+  auto stack = std::make_unique<strobe::TreiberStack<std::string>>();
+  for (int i = 0; i < 6; ++i) {
+    stack->emplace(64, static_cast<char>('a' + i));
+  }
+  EXPECT_EQ(stack->try_pop(), std::string(64, 'f'));
+  // The remaining strings are destroyed with the stack.
+  stack.reset();
+}
+
+// Threads push and pop concurrently, such that nodes are recycled while
+// other threads still race on them (ABA). No element may be lost or
+// duplicated.
+TEST(container_treiber_stack, stress) {
+  constexpr int ThreadCount = 8;
+  constexpr int PerThread = 100000;
+  strobe::TreiberStack<int> stack;
+
+  std::vector<std::vector<int>> popped(ThreadCount);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < ThreadCount; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < PerThread; ++i) {
+        stack.push(t * PerThread + i);
+        if (i % 2 == 1) {
+          for (int k = 0; k < 2; ++k) {
+            if (auto v = stack.try_pop()) {
+              popped[t].push_back(*v);
+            }
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<int> all;
+  for (const auto &p : popped) {
+    all.insert(all.end(), p.begin(), p.end());
+  }
+  while (auto v = stack.try_pop()) {
+    all.push_back(*v);
+  }
+  std::ranges::sort(all);
+  std::vector<int> expected(ThreadCount * PerThread);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(all, expected) << "Elements were lost or duplicated";
+}
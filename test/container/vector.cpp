@@ -0,0 +1,112 @@
+#include "container/vector.hpp"
+#include "memory/Mallocator.hpp"
+#include "type_traits/is_trivially_relocatable.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Counts move constructions, opts in to trivial relocation.
+struct Tracked {
+  static inline int moves = 0;
+  explicit Tracked(int v) : value(std::make_unique<int>(v)) {}
+  Tracked(Tracked &&o) noexcept : value(std::move(o.value)) { ++moves; }
+  Tracked &operator=(Tracked &&o) noexcept {
+    value = std::move(o.value);
+    return *this;
+  }
+  std::unique_ptr<int> value;
+};
+
+} // namespace
+
+template <> struct strobe::is_trivially_relocatable<Tracked> : std::true_type {};
+
+static_assert(strobe::is_trivially_relocatable_v<int>);
+static_assert(strobe::is_trivially_relocatable_v<std::unique_ptr<int>>);
+static_assert(strobe::is_trivially_relocatable_v<std::shared_ptr<int>>);
+static_assert(
+    strobe::is_trivially_relocatable_v<std::pair<int, std::unique_ptr<int>>>);
+#if defined(_GLIBCXX_DEBUG)
+static_assert(!strobe::is_trivially_relocatable_v<std::vector<int>>);
+#else
+static_assert(strobe::is_trivially_relocatable_v<std::vector<int>>);
+#endif
+static_assert(strobe::is_trivially_relocatable_v<strobe::Vector<int>>);
+static_assert(
+    strobe::is_trivially_relocatable_v<strobe::Vector<strobe::Vector<int>>>);
+static_assert(!strobe::is_trivially_relocatable_v<std::string>);
+
+TEST(container_vector, relocates_without_moving) {
+  Tracked::moves = 0;
+  strobe::Vector<Tracked> vec;
+  for (int i = 0; i < 1000; ++i) {
+    vec.emplace_back(i);
+  }
+  vec.pop_front();
+  vec.pop_front();
+  EXPECT_EQ(Tracked::moves, 0);
+  ASSERT_EQ(vec.size(), 998);
+  for (int i = 0; i < 998; ++i) {
+    EXPECT_EQ(*vec[i].value, i + 2);
+  }
+}
+
+TEST(container_vector, owning_elements) {
+  strobe::Vector<std::unique_ptr<int>> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back(std::make_unique<int>(i));
+  }
+  vec.pop_front();
+  ASSERT_EQ(vec.size(), 99);
+  for (int i = 0; i < 99; ++i) {
+    EXPECT_EQ(*vec[i], i + 1);
+  }
+}
+
+TEST(container_vector, shared_elements_are_not_leaked) {
+  auto shared = std::make_shared<int>(42);
+  {
+    strobe::Vector<std::shared_ptr<int>> vec;
+    for (int i = 0; i < 10; ++i) {
+      vec.push_back(shared);
+    }
+    EXPECT_EQ(shared.use_count(), 11);
+    // Insert with and without growing the buffer.
+    vec.insert(vec.begin() + 3, shared);
+    vec.reserve(64);
+    vec.insert(vec.begin() + 3, shared);
+    vec.insert(vec.begin() + 1, std::vector<std::shared_ptr<int>>(4, shared));
+    EXPECT_EQ(shared.use_count(), 17);
+    vec.pop_front();
+    EXPECT_EQ(shared.use_count(), 16);
+
+    strobe::Vector<std::shared_ptr<int>> other;
+    other.push_back(shared);
+    other = std::move(vec);
+    EXPECT_EQ(shared.use_count(), 16);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(container_vector, vector_of_vectors) {
+  strobe::Vector<strobe::Vector<int>> vec;
+  for (int i = 0; i < 100; ++i) {
+    strobe::Vector<int> inner;
+    for (int j = 0; j < i; ++j) {
+      inner.push_back(j);
+    }
+    vec.push_back(std::move(inner));
+  }
+  vec.insert(vec.begin(), strobe::Vector<int>(3, 7));
+  ASSERT_EQ(vec.size(), 101);
+  EXPECT_EQ(vec[0].size(), 3);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(vec[i + 1].size(), i);
+    for (int j = 0; j < i; ++j) {
+      EXPECT_EQ(vec[i + 1][j], j);
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#include "memory/AllocatorTraits.hpp"
+#include "memory/BuddyResource.hpp"
+#include "memory/Mallocator.hpp"
+#include "memory/PageAllocator.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace {
+
+// Allocator without reallocate or allocate_at_least.
+class PlainAllocator {
+public:
+  void *allocate(std::size_t size, std::size_t) {
+    ++allocations;
+    return std::malloc(size);
+  }
+  void deallocate(void *ptr, std::size_t, std::size_t) {
+    ++deallocations;
+    std::free(ptr);
+  }
+  int allocations = 0;
+  int deallocations = 0;
+};
+static_assert(!strobe::ReAllocator<PlainAllocator>);
+static_assert(!strobe::OverAllocator<PlainAllocator>);
+
+} // namespace
+
+TEST(AllocatorTraits, allocate_at_least_fallback) {
+  using Traits = strobe::AllocatorTraits<PlainAllocator>;
+  PlainAllocator alloc;
+  auto [p, n] = Traits::allocate_at_least<std::uint32_t>(alloc, 10);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(n, 10);
+  Traits::deallocate(alloc, p, n);
+}
+
+TEST(AllocatorTraits, reallocate_fallback_copies) {
+  using Traits = strobe::AllocatorTraits<PlainAllocator>;
+  PlainAllocator alloc;
+  std::uint32_t *p = Traits::allocate<std::uint32_t>(alloc, 8);
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    p[i] = i;
+  }
+  p = Traits::reallocate(alloc, p, 8, 1024);
+  ASSERT_NE(p, nullptr);
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(p[i], i);
+  }
+  EXPECT_EQ(alloc.allocations, 2);
+  EXPECT_EQ(alloc.deallocations, 1);
+  Traits::deallocate(alloc, p, 1024);
+}
+
+TEST(AllocatorTraits, reallocate_native) {
+  using Traits = strobe::AllocatorTraits<strobe::Mallocator>;
+  strobe::Mallocator alloc;
+  std::uint32_t *p = Traits::allocate<std::uint32_t>(alloc, 8);
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    p[i] = i;
+  }
+  p = Traits::reallocate(alloc, p, 8, 1024);
+  ASSERT_NE(p, nullptr);
+  for (std::uint32_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(p[i], i);
+  }
+  Traits::deallocate(alloc, p, 1024);
+}
+
+TEST(AllocatorTraits, allocate_at_least_buddy_block) {
+  using Resource = strobe::BuddyResource<1 << 12, 16>;
+  using Traits = strobe::AllocatorTraits<Resource>;
+  auto resource = std::make_unique<Resource>();
+  auto [p, size] = Traits::allocate_at_least(*resource, 100, 16);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(size, 128);
+  // The whole block is ours, the next allocation must not overlap.
+  void *q = resource->allocate(16, 16);
+  EXPECT_TRUE(static_cast<std::byte *>(q) >= static_cast<std::byte *>(p) + 128 ||
+              static_cast<std::byte *>(q) + 16 <= static_cast<std::byte *>(p));
+  Traits::deallocate(*resource, p, size, 16);
+  resource->deallocate(q, 16, 16);
+}
+
+// Reallocating to 0 bytes is rejected instead of freeing the allocation,
+// nullptr always means failure with the old allocation still valid.
+TEST(AllocatorTraits, reallocate_zero_size_asserts) {
+#ifdef NDEBUG
+  GTEST_SKIP() << "requires assertions";
+#else
+  PlainAllocator plain;
+  void *p = strobe::AllocatorTraits<PlainAllocator>::allocate(plain, 64, 8);
+  EXPECT_DEATH(strobe::AllocatorTraits<PlainAllocator>::reallocate(plain, p,
+                                                                   64, 0, 8),
+               "deallocate");
+  strobe::AllocatorTraits<PlainAllocator>::deallocate(plain, p, 64, 8);
+
+  strobe::Mallocator mallocator;
+  p = mallocator.allocate(64, 8);
+  EXPECT_DEATH(mallocator.reallocate(p, 64, 0, 8), "deallocate");
+  mallocator.deallocate(p, 64, 8);
+
+  strobe::PageAllocator pages;
+  p = pages.allocate(64, 8);
+  EXPECT_DEATH((void)pages.reallocate(p, 64, 0, 8), "deallocate");
+  pages.deallocate(p, 64, 8);
+#endif
+}
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <memory>
 #include <random>
 
 using namespace strobe;
@@ -200,3 +201,44 @@ TEST(BuddyAllocator, random_alloc_dealloc) {
     }
   }
 }
+
+TEST(BuddyAllocator, mixed_sizes_coalesce_completely) {
+  constexpr std::size_t Capacity = 1ull << 16;
+  auto resource = std::make_unique<strobe::BuddyResource<Capacity, 16>>();
+
+  struct Allocation {
+    std::uint8_t *ptr;
+    std::size_t size;
+    std::uint8_t tag;
+  };
+  std::vector<Allocation> live;
+  std::mt19937 rng(1);
+  for (int i = 0; i < 100000; ++i) {
+    if (live.empty() || rng() % 2 == 0) {
+      const std::size_t size = 16u << (rng() % 6);
+      auto *p = static_cast<std::uint8_t *>(resource->allocate(size, 16));
+      if (p == nullptr) {
+        continue;
+      }
+      const auto tag = static_cast<std::uint8_t>(rng());
+      std::memset(p, tag, size);
+      live.push_back({p, size, tag});
+    } else {
+      const std::size_t j = rng() % live.size();
+      const Allocation a = live[j];
+      for (std::size_t k = 0; k < a.size; ++k) {
+        ASSERT_EQ(a.ptr[k], a.tag) << "Allocation is overlapping";
+      }
+      resource->deallocate(a.ptr, a.size, 16);
+      live[j] = live.back();
+      live.pop_back();
+    }
+  }
+  for (const Allocation &a : live) {
+    resource->deallocate(a.ptr, a.size, 16);
+  }
+  // After freeing everything all buddies must have been coalesced again.
+  void *all = resource->allocate(Capacity, 16);
+  EXPECT_NE(all, nullptr);
+  resource->deallocate(all, Capacity, 16);
+}
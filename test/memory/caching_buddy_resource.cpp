@@ -0,0 +1,104 @@
+#include "memory/CachingBuddyResource.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(CachingBuddyResource, simple_allocations) {
+  static constexpr std::size_t COUNT = 64;
+  auto resource = std::make_unique<
+      strobe::CachingBuddyResource<sizeof(std::uint64_t) * COUNT,
+                                   sizeof(std::uint64_t)>>();
+
+  std::vector<std::uint64_t *> allocations(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    allocations[i] = reinterpret_cast<std::uint64_t *>(
+        resource->allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+    ASSERT_NE(allocations[i], nullptr) << "Allocation " << i << " failed";
+    EXPECT_TRUE(resource->owns(allocations[i]));
+    *allocations[i] = i;
+  }
+  for (std::uint64_t i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(*allocations[i], i) << "Allocation " << i << " is overlapping";
+  }
+  EXPECT_EQ(
+      resource->allocate(sizeof(std::uint64_t), alignof(std::uint64_t)),
+      nullptr)
+      << "Overallocations should return nullptr";
+
+  for (auto *p : allocations) {
+    resource->deallocate(p, sizeof(std::uint64_t), alignof(std::uint64_t));
+  }
+}
+
+TEST(CachingBuddyResource, large_allocations_bypass_cache) {
+  auto resource =
+      std::make_unique<strobe::CachingBuddyResource<1 << 16, 16, strobe::PageAllocator, 4, 2>>();
+  void *large = resource->allocate(1 << 12, 16);
+  ASSERT_NE(large, nullptr);
+  void *small = resource->allocate(16, 16);
+  ASSERT_NE(small, nullptr);
+  EXPECT_TRUE(small < large ||
+              static_cast<std::byte *>(small) >=
+                  static_cast<std::byte *>(large) + (1 << 12));
+  resource->deallocate(large, 1 << 12, 16);
+  resource->deallocate(small, 16, 16);
+}
+
+TEST(CachingBuddyResource, concurrent_alloc_dealloc) {
+  constexpr std::size_t Capacity = 1ull << 22;
+  constexpr std::size_t ThreadCount = 8;
+  using Resource = strobe::CachingBuddyResource<Capacity, 16,
+                                                strobe::PageAllocator, 8, 4, 4>;
+  auto resource = std::make_unique<Resource>();
+
+  struct Allocation {
+    std::uint8_t *ptr;
+    std::size_t size;
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<int> failures(ThreadCount, 0);
+  for (std::size_t t = 0; t < ThreadCount; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      std::vector<Allocation> live;
+      const auto tag = static_cast<std::uint8_t>(t + 1);
+      for (int i = 0; i < 20000; ++i) {
+        if (live.empty() || rng() % 2 == 0) {
+          const std::size_t size = 16u << (rng() % 6);
+          auto *p = static_cast<std::uint8_t *>(resource->allocate(size, 16));
+          if (p == nullptr) {
+            continue;
+          }
+          std::memset(p, tag, size);
+          live.push_back({p, size});
+        } else {
+          const std::size_t j = rng() % live.size();
+          Allocation a = live[j];
+          if (std::any_of(a.ptr, a.ptr + a.size,
+                          [&](std::uint8_t b) { return b != tag; })) {
+            ++failures[t];
+          }
+          resource->deallocate(a.ptr, a.size, 16);
+          live[j] = live.back();
+          live.pop_back();
+        }
+      }
+      for (Allocation a : live) {
+        resource->deallocate(a.ptr, a.size, 16);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (std::size_t t = 0; t < ThreadCount; ++t) {
+    EXPECT_EQ(failures[t], 0) << "Thread " << t << " observed overlapping blocks";
+  }
+}
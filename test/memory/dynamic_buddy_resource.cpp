@@ -0,0 +1,96 @@
+#include "memory/DynamicBuddyResource.hpp"
+#include "memory/Mallocator.hpp"
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+TEST(DynamicBuddyResource, runtime_capacity_is_rounded_up) {
+  strobe::DynamicBuddyResource<16> resource{1000};
+  EXPECT_EQ(resource.arena_capacity(), 1024);
+  EXPECT_EQ(resource.arena_count(), 0);
+
+  void *p = resource.allocate(1024, 16);
+  ASSERT_NE(p, nullptr);
+  EXPECT_TRUE(resource.owns(p));
+  EXPECT_EQ(resource.arena_count(), 1);
+  EXPECT_EQ(resource.allocate(2048, 16), nullptr)
+      << "Allocations larger than a arena should fail";
+  resource.deallocate(p, 1024, 16);
+}
+
+TEST(DynamicBuddyResource, grows_additional_arenas) {
+  static constexpr std::size_t COUNT = 32;
+  strobe::DynamicBuddyResource<sizeof(std::uint32_t)> resource{
+      sizeof(std::uint32_t) * COUNT};
+
+  std::vector<std::uint32_t *> allocations(COUNT * 4);
+  for (std::size_t i = 0; i < allocations.size(); ++i) {
+    allocations[i] = reinterpret_cast<std::uint32_t *>(
+        resource.allocate(sizeof(std::uint32_t), alignof(std::uint32_t)));
+    ASSERT_NE(allocations[i], nullptr) << "Allocation " << i << " failed";
+    EXPECT_TRUE(resource.owns(allocations[i]));
+    *allocations[i] = static_cast<std::uint32_t>(i);
+  }
+  EXPECT_EQ(resource.arena_count(), 4);
+
+  for (std::size_t i = 0; i < allocations.size(); ++i) {
+    EXPECT_EQ(*allocations[i], i) << "Allocation " << i << " is overlapping";
+  }
+  // Free in a order which interleaves the arenas.
+  for (std::size_t i = 0; i < allocations.size(); i += 2) {
+    resource.deallocate(allocations[i], sizeof(std::uint32_t),
+                        alignof(std::uint32_t));
+  }
+  for (std::size_t i = 1; i < allocations.size(); i += 2) {
+    resource.deallocate(allocations[i], sizeof(std::uint32_t),
+                        alignof(std::uint32_t));
+  }
+  // Everything was coalesced, no new arena required.
+  for (std::size_t i = 0; i < 4; ++i) {
+    void *p = resource.allocate(sizeof(std::uint32_t) * COUNT,
+                                alignof(std::uint32_t));
+    EXPECT_NE(p, nullptr);
+  }
+  EXPECT_EQ(resource.arena_count(), 4);
+
+  int x;
+  EXPECT_FALSE(resource.owns(&x));
+}
+
+TEST(DynamicBuddyResource, random_alloc_dealloc) {
+  strobe::DynamicBuddyResource<16, strobe::Mallocator> resource{1 << 14};
+
+  struct Allocation {
+    std::uint8_t *ptr;
+    std::size_t size;
+    std::uint8_t tag;
+  };
+  std::vector<Allocation> live;
+  std::mt19937 rng(7);
+  for (int i = 0; i < 100000; ++i) {
+    if (live.empty() || rng() % 2 == 0) {
+      const std::size_t size = 16u << (rng() % 8);
+      auto *p = static_cast<std::uint8_t *>(resource.allocate(size, 16));
+      ASSERT_NE(p, nullptr);
+      ASSERT_TRUE(resource.owns(p));
+      const auto tag = static_cast<std::uint8_t>(rng());
+      std::memset(p, tag, size);
+      live.push_back({p, size, tag});
+    } else {
+      const std::size_t j = rng() % live.size();
+      const Allocation a = live[j];
+      for (std::size_t k = 0; k < a.size; ++k) {
+        ASSERT_EQ(a.ptr[k], a.tag) << "Allocation is overlapping";
+      }
+      resource.deallocate(a.ptr, a.size, 16);
+      live[j] = live.back();
+      live.pop_back();
+    }
+  }
+  EXPECT_GT(resource.arena_count(), 1);
+  for (const Allocation &a : live) {
+    resource.deallocate(a.ptr, a.size, 16);
+  }
+}
@@ -0,0 +1,196 @@
+#include "memory/FreelistPool.hpp"
+#include "memory/Mallocator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+TEST(FreelistResource, simple_allocations) {
+  static constexpr std::size_t COUNT = 32;
+  strobe::FreelistResource<sizeof(std::uint64_t), alignof(std::uint64_t)>
+      resource;
+
+  std::vector<std::uint64_t *> allocations(COUNT);
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    allocations[i] = reinterpret_cast<std::uint64_t *>(
+        resource.allocate(sizeof(std::uint64_t), alignof(std::uint64_t)));
+    EXPECT_NE(allocations[i], nullptr) << "Allocation " << i << " failed";
+    EXPECT_TRUE(resource.owns(allocations[i]))
+        << "Allocation " << i << " is not owned by resource";
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(allocations[i]) %
+                  alignof(std::uint64_t),
+              0);
+  }
+
+  for (std::uint64_t i = 0; i < COUNT; ++i) {
+    *allocations[i] = i;
+  }
+
+  for (std::uint64_t i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(*allocations[i], i) << "Allocation " << i << " is overlapping";
+  }
+
+  int x;
+  EXPECT_FALSE(resource.owns(&x));
+}
+
+TEST(FreelistResource, reuses_freed_blocks) {
+  strobe::FreelistResource<32, 16> resource;
+
+  void *a1 = resource.allocate(32, 16);
+  void *b = resource.allocate(32, 16);
+  EXPECT_NE(a1, b);
+  resource.deallocate(a1, 32, 16);
+  void *a2 = resource.allocate(32, 16);
+  EXPECT_EQ(a1, a2);
+  resource.deallocate(a2, 32, 16);
+  resource.deallocate(b, 32, 16);
+}
+
+TEST(FreelistResource, grows_by_chaining_slabs) {
+  // A tiny first slab forces the resource to chain many slabs.
+  strobe::FreelistResource<16, 16, strobe::Mallocator> resource{{}, 2};
+
+  static constexpr std::size_t COUNT = 1000;
+  std::vector<std::uint32_t *> allocations(COUNT);
+  std::set<std::uint32_t *> unique;
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    allocations[i] = reinterpret_cast<std::uint32_t *>(resource.allocate(16, 16));
+    ASSERT_NE(allocations[i], nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(allocations[i]) % 16, 0);
+    *allocations[i] = static_cast<std::uint32_t>(i);
+    unique.insert(allocations[i]);
+  }
+  EXPECT_EQ(unique.size(), COUNT);
+
+  for (std::size_t i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(*allocations[i], i) << "Allocation " << i << " is overlapping";
+    EXPECT_TRUE(resource.owns(allocations[i]));
+  }
+}
+
+TEST(FreelistResource, random_alloc_dealloc) {
+  strobe::FreelistResource<sizeof(std::uint32_t) * 4, alignof(std::uint32_t)>
+      resource;
+
+  constexpr std::size_t count = 1 << 14;
+  std::vector<std::uint32_t *> allocations(count, nullptr);
+  std::vector<std::size_t> shflIdx(2 * count);
+  for (std::size_t i = 0; i < count; ++i) {
+    shflIdx[2 * i] = i;
+    shflIdx[2 * i + 1] = i;
+  }
+
+  std::mt19937 rng;
+  for (std::uint32_t it = 0; it < 4; ++it) {
+    std::ranges::shuffle(shflIdx, rng);
+    for (auto idx : shflIdx) {
+      if (allocations[idx] == nullptr) {
+        allocations[idx] = reinterpret_cast<std::uint32_t *>(resource.allocate(
+            sizeof(std::uint32_t) * 4, alignof(std::uint32_t)));
+        ASSERT_NE(allocations[idx], nullptr);
+        std::fill_n(allocations[idx], 4, static_cast<std::uint32_t>(idx));
+      } else {
+        for (std::size_t j = 0; j < 4; ++j) {
+          ASSERT_EQ(allocations[idx][j], idx);
+        }
+        resource.deallocate(allocations[idx], sizeof(std::uint32_t) * 4,
+                            alignof(std::uint32_t));
+        allocations[idx] = nullptr;
+      }
+    }
+  }
+}
+
+TEST(FreelistResource, move_transfers_ownership) {
+  strobe::FreelistResource<8, 8> resource;
+  void *p = resource.allocate(8, 8);
+  ASSERT_NE(p, nullptr);
+
+  strobe::FreelistResource<8, 8> moved{std::move(resource)};
+  EXPECT_TRUE(moved.owns(p));
+  EXPECT_FALSE(resource.owns(p));
+  moved.deallocate(p, 8, 8);
+
+  resource = std::move(moved);
+  EXPECT_TRUE(resource.owns(p));
+  EXPECT_EQ(resource.allocate(8, 8), p);
+}
+
+TEST(FreelistResource, absorb_takes_over_slabs) {
+  strobe::FreelistResource<16, 16, strobe::Mallocator> a{{}, 2};
+  strobe::FreelistResource<16, 16, strobe::Mallocator> b{{}, 2};
+  std::vector<void *> fromA;
+  std::vector<void *> fromB;
+  for (int i = 0; i < 10; ++i) {
+    fromA.push_back(a.allocate(16, 16));
+    fromB.push_back(b.allocate(16, 16));
+  }
+  b.deallocate(fromB.back(), 16, 16);
+  fromB.pop_back();
+
+  a.absorb(std::move(b));
+  for (void *p : fromB) {
+    EXPECT_TRUE(a.owns(p));
+    EXPECT_FALSE(b.owns(p));
+  }
+  for (void *p : fromB) {
+    a.deallocate(p, 16, 16);
+  }
+  // b is empty, but still usable.
+  void *p = b.allocate(16, 16);
+  EXPECT_TRUE(b.owns(p));
+  EXPECT_FALSE(a.owns(p));
+
+  std::set<void *> live(fromA.begin(), fromA.end());
+  for (int i = 0; i < 100; ++i) {
+    void *q = a.allocate(16, 16);
+    EXPECT_TRUE(live.insert(q).second);
+  }
+}
+
+TEST(FreelistResource, absorb_keeps_free_blocks_of_both) {
+  using Resource = strobe::FreelistResource<16, 16, strobe::Mallocator>;
+  Resource a{{}, 4};
+  Resource b{{}, 4};
+  // Both have a free block and two uncarved chunks left.
+  std::byte *a0 = static_cast<std::byte *>(a.allocate(16, 16));
+  std::byte *a1 = static_cast<std::byte *>(a.allocate(16, 16));
+  std::byte *b0 = static_cast<std::byte *>(b.allocate(16, 16));
+  std::byte *b1 = static_cast<std::byte *>(b.allocate(16, 16));
+  a.deallocate(a0, 16, 16);
+  b.deallocate(b0, 16, 16);
+
+  a.absorb(std::move(b));
+  std::set<void *> expected{a0, b0, a1 + 16, a1 + 32, b1 + 16, b1 + 32};
+  std::set<void *> allocated;
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    allocated.insert(a.allocate(16, 16));
+  }
+  EXPECT_EQ(allocated, expected);
+
+  // Only now a new slab is required.
+  void *p = a.allocate(16, 16);
+  EXPECT_FALSE(expected.contains(p));
+  EXPECT_TRUE(a.owns(p));
+
+  // The rest of c is parked and handed on to d together with a.
+  Resource c{{}, 4};
+  std::byte *c0 = static_cast<std::byte *>(c.allocate(16, 16));
+  a.absorb(std::move(c));
+  Resource d{{}, 4};
+  d.absorb(std::move(a));
+  expected.clear();
+  for (std::size_t k = 1; k < 8; ++k) {
+    expected.insert(static_cast<std::byte *>(p) + 16 * k);
+  }
+  for (std::size_t k = 1; k < 4; ++k) {
+    expected.insert(c0 + 16 * k);
+  }
+  allocated.clear();
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    allocated.insert(d.allocate(16, 16));
+  }
+  EXPECT_EQ(allocated, expected);
+}
@@ -1,3 +1,5 @@
+#include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory/Mallocator.hpp>
 
@@ -14,3 +16,43 @@ TEST(Mallocator, trivial) {
 }
 
 
+TEST(Mallocator, allocate_at_least) {
+  strobe::Mallocator mallocator;
+  auto [p, size] = mallocator.allocate_at_least(13, 1);
+  ASSERT_NE(p, nullptr);
+  EXPECT_GE(size, 13);
+  mallocator.deallocate(p, size, 1);
+}
+
+TEST(Mallocator, reallocate_preserves_content) {
+  strobe::Mallocator mallocator;
+  auto *p = static_cast<std::uint32_t *>(
+      mallocator.allocate(16 * sizeof(std::uint32_t), alignof(std::uint32_t)));
+  for (std::uint32_t i = 0; i < 16; ++i) {
+    p[i] = i;
+  }
+  p = static_cast<std::uint32_t *>(
+      mallocator.reallocate(p, 16 * sizeof(std::uint32_t),
+                            1024 * sizeof(std::uint32_t),
+                            alignof(std::uint32_t)));
+  ASSERT_NE(p, nullptr);
+  for (std::uint32_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(p[i], i);
+  }
+  mallocator.deallocate(p);
+}
+
+TEST(Mallocator, over_aligned) {
+  strobe::Mallocator mallocator;
+  for (std::size_t align : {64, 128, 4096}) {
+    void *p = mallocator.allocate(100, align);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % align, 0);
+    std::memset(p, 0x7F, 100);
+    p = mallocator.reallocate(p, 100, 10000, align);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % align, 0);
+    EXPECT_EQ(static_cast<unsigned char *>(p)[99], 0x7F);
+    mallocator.deallocate(p, 10000, align);
+  }
+}
@@ -1,4 +1,6 @@
 #include "memory/pages.hpp"
+#include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory/PageAllocator.hpp>
 
@@ -32,3 +34,44 @@ TEST(PageAllocator, large) {
 
   allocator.deallocate(p, 1 << 29, alignof(std::uint64_t));
 }
+
+TEST(PageAllocator, allocate_at_least_reports_pages) {
+  strobe::PageAllocator allocator;
+  auto [p, size] = allocator.allocate_at_least(10, 1);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(size, strobe::page_size());
+  std::memset(p, 0xAB, size);
+  allocator.deallocate(p, size, 1);
+}
+
+TEST(PageAllocator, reallocate) {
+  strobe::PageAllocator allocator;
+  const std::size_t page = strobe::page_size();
+  const std::size_t n = page / sizeof(std::uint64_t);
+
+  auto *x = static_cast<std::uint64_t *>(
+      allocator.allocate(page, alignof(std::uint64_t)));
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = i;
+  }
+  // Within the same page nothing has to happen.
+  EXPECT_EQ(allocator.reallocate(x, page, page - 8, alignof(std::uint64_t)),
+            x);
+
+  x = static_cast<std::uint64_t *>(
+      allocator.reallocate(x, page, 64 * page, alignof(std::uint64_t)));
+  ASSERT_NE(x, nullptr);
+  ASSERT_TRUE((reinterpret_cast<std::intptr_t>(x) % page) == 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(x[i], i);
+  }
+  x[64 * n - 1] = 42;
+
+  x = static_cast<std::uint64_t *>(
+      allocator.reallocate(x, 64 * page, 2 * page, alignof(std::uint64_t)));
+  ASSERT_NE(x, nullptr);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(x[i], i);
+  }
+  allocator.deallocate(x, 2 * page, alignof(std::uint64_t));
+}